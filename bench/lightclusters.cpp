@@ -0,0 +1,39 @@
+#include "ige/core/Bounds.hpp"
+#include "ige/plugin/render/LightClusters.hpp"
+#include <benchmark/benchmark.h>
+#include <glm/vec3.hpp>
+#include <random>
+#include <vector>
+
+using ige::core::BoundingSphere;
+using ige::plugin::render::LightClusters;
+
+// point lights of 1 to 8 units of range, in front of the camera
+static void assign(benchmark::State& state)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> xy(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(1.0f, 80.0f);
+    std::uniform_real_distribution<float> range(1.0f, 8.0f);
+
+    std::vector<BoundingSphere> lights(state.range(0));
+
+    for (auto& light : lights) {
+        light.center = { xy(rng), xy(rng), -depth(rng) };
+        light.radius = range(rng);
+    }
+
+    LightClusters clusters;
+    clusters.set_projection(1.2f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+    for (auto _ : state) {
+        clusters.assign(lights);
+        benchmark::DoNotOptimize(clusters.indices().data());
+    }
+
+    state.counters["pairs"] = double(clusters.indices().size());
+}
+
+BENCHMARK(assign)->Arg(200)->Arg(4000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
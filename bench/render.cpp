@@ -0,0 +1,191 @@
+#include "ige/asset/Material.hpp"
+#include "ige/asset/Mesh.hpp"
+#include "ige/core/App.hpp"
+#include "ige/core/State.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "ige/plugin/WindowPlugin.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <random>
+#include <vector>
+
+using glm::vec3;
+using glm::vec4;
+using ige::asset::Material;
+using ige::asset::Mesh;
+using ige::core::App;
+using ige::core::State;
+using ige::ecs::EntityId;
+using ige::plugin::render::GeometryPassOptions;
+using ige::plugin::render::GpuFrameTime;
+using ige::plugin::render::Light;
+using ige::plugin::render::LightPassOptions;
+using ige::plugin::render::MeshRenderer;
+using ige::plugin::render::PerspectiveCamera;
+using ige::plugin::render::RenderPlugin;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::TransformPlugin;
+using ige::plugin::window::WindowPlugin;
+using ige::plugin::window::WindowSettings;
+
+using Clock = std::chrono::steady_clock;
+
+// frames drawn before measuring, while programs and buffers are created
+const std::size_t WARMUP_FRAMES = 10;
+
+struct FrameTimes {
+    double cpu_ms = 0.0;
+    std::size_t cpu_frames = 0;
+    double gpu_ms = 0.0;
+    std::size_t gpu_frames = 0;
+};
+
+// 32x32 spinning cubes under 64 point lights
+class CannedScene : public State {
+public:
+    CannedScene(std::size_t frames, bool optimized, FrameTimes& times)
+        : m_frames(frames)
+        , m_optimized(optimized)
+        , m_times(times)
+    {
+    }
+
+    void on_start(App& app) override
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        auto mesh = Mesh::make_cube(1.0f);
+        std::vector<Material::Handle> materials;
+
+        for (int i = 0; i < 4; i++) {
+            auto material = Material::make_default();
+            material->set(
+                "base_color_factor",
+                vec4 { unit(rng), unit(rng), unit(rng), 1.0f });
+            materials.push_back(material);
+        }
+
+        for (int x = 0; x < 32; x++) {
+            for (int z = 0; z < 32; z++) {
+                m_cubes.push_back(app.world().create_entity(
+                    Transform::from_pos({ x * 2.0f - 31.0f, 0.0f, -z * 2.0f }),
+                    MeshRenderer { mesh, materials[(x + z) % 4] }));
+            }
+        }
+
+        app.world().create_entity(Light::ambient(0.1f));
+        app.world().create_entity(
+            Transform {}.set_rotation(vec3 { 45.0f, 45.0f, 0.0f }),
+            Light::directional(0.5f));
+
+        for (int i = 0; i < 64; i++) {
+            vec3 pos { unit(rng) * 64.0f - 32.0f, 2.0f, unit(rng) * -64.0f };
+            vec3 color { unit(rng), unit(rng), unit(rng) };
+
+            app.world().create_entity(
+                Transform::from_pos(pos), Light::point(1.0f, 6.0f, color));
+        }
+
+        app.world().create_entity(
+            Transform::from_pos(vec3(0.0f, 12.0f, 8.0f))
+                .look_at(vec3(0.0f, 0.0f, -24.0f)),
+            PerspectiveCamera(70.0f));
+
+        if (m_optimized) {
+            app.render_world().insert(GeometryPassOptions { true, true });
+            app.render_world().insert(
+                LightPassOptions { LightPassOptions::Bounds::SCISSOR, true });
+        }
+
+        app.render_world().insert(GpuFrameTime {});
+    }
+
+    void on_update(App& app) override
+    {
+        auto now = Clock::now();
+
+        // the time between two updates covers the whole previous frame
+        if (m_frame > WARMUP_FRAMES) {
+            std::chrono::duration<double, std::milli> cpu = now - m_last_update;
+
+            m_times.cpu_ms += cpu.count();
+            m_times.cpu_frames++;
+
+            auto gpu = app.render_world().get<GpuFrameTime>();
+
+            if (gpu->frames > m_gpu_frames) {
+                m_times.gpu_ms += gpu->milliseconds;
+                m_times.gpu_frames++;
+            }
+        }
+
+        m_gpu_frames = app.render_world().get<GpuFrameTime>()->frames;
+        m_last_update = now;
+
+        // deterministic motion, regardless of the frame rate
+        float angle = float(m_frame) * 2.0f;
+
+        for (EntityId cube : m_cubes) {
+            app.world().get_component<Transform>(cube)->set_rotation(
+                vec3(angle, angle * 0.5f, 0.0f));
+        }
+
+        if (++m_frame == m_frames + WARMUP_FRAMES) {
+            app.quit();
+        }
+    }
+
+private:
+    std::size_t m_frames;
+    bool m_optimized;
+    FrameTimes& m_times;
+
+    std::vector<EntityId> m_cubes;
+    std::size_t m_frame = 0;
+    std::size_t m_gpu_frames = 0;
+    Clock::time_point m_last_update;
+};
+
+// renders `range(0)` frames offscreen, with the default render options or
+// with the depth pre-pass and clustered lights when `range(1)` is set
+static void render_frames(benchmark::State& state)
+{
+    FrameTimes times;
+
+    for (auto _ : state) {
+        App::Builder()
+            .insert(WindowSettings {
+                .title = "bench_render",
+                .width = 1280,
+                .height = 720,
+                .headless = true,
+            })
+            .add_plugin(TransformPlugin {})
+            .add_plugin(WindowPlugin {})
+            .add_plugin(RenderPlugin {})
+            .run<CannedScene>(
+                std::size_t(state.range(0)), state.range(1) != 0, times);
+    }
+
+    if (times.cpu_frames > 0) {
+        state.counters["cpu_ms"] = times.cpu_ms / double(times.cpu_frames);
+    }
+
+    if (times.gpu_frames > 0) {
+        state.counters["gpu_ms"] = times.gpu_ms / double(times.gpu_frames);
+    }
+}
+
+BENCHMARK(render_frames)
+    ->Args({ 300, 0 })
+    ->Args({ 300, 1 })
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,246 @@
+#include "ige/core/Bounds.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/plugin/spatial/SpatialIndex.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/vec3.hpp>
+#include <random>
+#include <vector>
+
+using glm::vec3;
+using ige::core::Aabb;
+using ige::core::BoundingSphere;
+using ige::core::Frustum;
+using ige::core::Ray;
+using ige::ecs::EntityId;
+using ige::plugin::spatial::SpatialIndex;
+
+// boxes of 0.5 to 2 units scattered in a 1000 units wide cube
+struct Scene {
+    std::mt19937 rng { 42 };
+    std::vector<EntityId> entities;
+    std::vector<Aabb> boxes;
+
+    Scene(std::size_t count)
+    {
+        std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+        for (std::size_t i = 0; i < count; i++) {
+            vec3 min { pos(rng), pos(rng), pos(rng) };
+
+            entities.push_back(EntityId(i, 0));
+            boxes.push_back({ min, min + vec3(size(rng)) });
+        }
+    }
+
+    void fill(SpatialIndex& index) const
+    {
+        for (std::size_t i = 0; i < entities.size(); i++) {
+            index.update(entities[i], boxes[i]);
+        }
+
+        index.rebalance();
+    }
+};
+
+static void insert(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+
+    for (auto _ : state) {
+        SpatialIndex index;
+
+        for (std::size_t i = 0; i < scene.entities.size(); i++) {
+            index.update(scene.entities[i], scene.boxes[i]);
+        }
+
+        benchmark::DoNotOptimize(index.height());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void rebalance(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+
+    scene.fill(index);
+
+    for (auto _ : state) {
+        index.rebalance();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// every entity moves a little: most stay in their fat box
+static void update_small_moves(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+    float step = 0.01f;
+
+    scene.fill(index);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < scene.entities.size(); i++) {
+            Aabb& box = scene.boxes[i];
+
+            box.min.x += step;
+            box.max.x += step;
+            index.update(scene.entities[i], box);
+        }
+
+        step = -step;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// a tenth of the entities teleport somewhere else every frame
+static void update_teleports(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+    std::size_t next = 0;
+
+    scene.fill(index);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < scene.entities.size() / 10; i++) {
+            std::size_t entity = next++ % scene.entities.size();
+            Aabb& box = scene.boxes[entity];
+            vec3 size = box.max - box.min;
+
+            box.min = { pos(scene.rng), pos(scene.rng), pos(scene.rng) };
+            box.max = box.min + size;
+            index.update(scene.entities[entity], box);
+        }
+
+        if (!index.balanced()) {
+            index.rebalance();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 10);
+}
+
+static void query_aabb(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+    std::vector<EntityId> out;
+
+    scene.fill(index);
+
+    for (auto _ : state) {
+        index.query(Aabb { vec3(-50.0f), vec3(50.0f) }, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+static void query_sphere(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+    std::vector<EntityId> out;
+
+    scene.fill(index);
+
+    for (auto _ : state) {
+        index.query(BoundingSphere { vec3(0.0f), 50.0f }, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+static void query_frustum(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+    std::vector<EntityId> out;
+
+    scene.fill(index);
+
+    Frustum frustum = Frustum::from_matrix(
+        glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+        * glm::lookAt(vec3(0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(0, 1, 0)));
+
+    for (auto _ : state) {
+        index.query(frustum, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.counters["visible"] = static_cast<double>(out.size());
+}
+
+static void query_ray(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    SpatialIndex index;
+    std::vector<EntityId> out;
+
+    scene.fill(index);
+
+    Ray ray { vec3(-600.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f) };
+
+    for (auto _ : state) {
+        index.query(ray, 1200.0f, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+// what every spatial question costs without an index
+static void scan_frustum(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    std::vector<EntityId> out;
+
+    Frustum frustum = Frustum::from_matrix(
+        glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+        * glm::lookAt(vec3(0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(0, 1, 0)));
+
+    for (auto _ : state) {
+        out.clear();
+
+        for (std::size_t i = 0; i < scene.entities.size(); i++) {
+            if (frustum.intersects(scene.boxes[i])) {
+                out.push_back(scene.entities[i]);
+            }
+        }
+
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+// same scan, testing 4 boxes at a time
+static void cull_frustum(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    std::vector<std::uint8_t> visible(scene.boxes.size());
+
+    Frustum frustum = Frustum::from_matrix(
+        glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+        * glm::lookAt(vec3(0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(0, 1, 0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frustum.cull(scene.boxes, visible));
+    }
+}
+
+BENCHMARK(insert)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(rebalance)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(update_small_moves)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(update_teleports)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(query_aabb)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(query_sphere)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(query_frustum)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(query_ray)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(scan_frustum)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cull_frustum)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
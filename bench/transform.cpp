@@ -0,0 +1,123 @@
+#include "ige/plugin/transform/Affine.hpp"
+#include <benchmark/benchmark.h>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <vector>
+
+using glm::mat4;
+using glm::quat;
+using glm::vec3;
+using ige::plugin::transform::Affine;
+
+struct Scene {
+    std::vector<vec3> translations;
+    std::vector<quat> rotations;
+    std::vector<vec3> scales;
+
+    Scene(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            float f = static_cast<float>(i);
+
+            translations.push_back(vec3(f, 2.0f * f, -f));
+            rotations.push_back(
+                glm::angleAxis(0.01f * f, glm::normalize(vec3(1.0f, f, 1.0f))));
+            scales.push_back(vec3(1.0f + 0.001f * f));
+        }
+    }
+};
+
+// what Transform::force_update used to do: build a mat4 and invert it
+static void glm_trs_inverse(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    std::vector<mat4> local_to_world(scene.translations.size());
+    std::vector<mat4> world_to_local(scene.translations.size());
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < local_to_world.size(); i++) {
+            mat4 m = glm::translate(mat4(1.0f), scene.translations[i])
+                * glm::mat4_cast(scene.rotations[i]);
+
+            local_to_world[i] = glm::scale(m, scene.scales[i]);
+            world_to_local[i] = glm::inverse(local_to_world[i]);
+        }
+
+        benchmark::DoNotOptimize(local_to_world.data());
+        benchmark::DoNotOptimize(world_to_local.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void affine_trs_inverse(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    std::vector<Affine> local_to_world(scene.translations.size());
+    std::vector<Affine> world_to_local(scene.translations.size());
+
+    for (auto _ : state) {
+        Affine::from_trs(
+            scene.translations, scene.rotations, scene.scales, local_to_world);
+
+        for (std::size_t i = 0; i < local_to_world.size(); i++) {
+            world_to_local[i] = local_to_world[i].inverse();
+        }
+
+        benchmark::DoNotOptimize(local_to_world.data());
+        benchmark::DoNotOptimize(world_to_local.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void glm_multiply(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    std::vector<mat4> matrices;
+
+    for (std::size_t i = 0; i < scene.translations.size(); i++) {
+        matrices.push_back(glm::translate(mat4(1.0f), scene.translations[i]));
+    }
+
+    mat4 parent = glm::mat4_cast(scene.rotations.back());
+
+    for (auto _ : state) {
+        for (mat4& m : matrices) {
+            m = parent * m;
+        }
+
+        benchmark::DoNotOptimize(matrices.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void affine_multiply(benchmark::State& state)
+{
+    Scene scene(state.range(0));
+    std::vector<Affine> matrices(scene.translations.size());
+
+    Affine::from_trs(
+        scene.translations, scene.rotations, scene.scales, matrices);
+
+    Affine parent = Affine::from_mat4(glm::mat4_cast(scene.rotations.back()));
+
+    for (auto _ : state) {
+        for (Affine& m : matrices) {
+            m = parent * m;
+        }
+
+        benchmark::DoNotOptimize(matrices.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(glm_trs_inverse)->Arg(64)->Arg(4096);
+BENCHMARK(affine_trs_inverse)->Arg(64)->Arg(4096);
+BENCHMARK(glm_multiply)->Arg(64)->Arg(4096);
+BENCHMARK(affine_multiply)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
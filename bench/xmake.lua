@@ -0,0 +1,22 @@
+add_requires("benchmark ^1.6.0")
+
+local benchmarks = {
+    ["lightclusters"] = { files = {"lightclusters.cpp"} },
+    ["render"] = { files = {"render.cpp"} },
+    ["spatialindex"] = { files = {"spatialindex.cpp"} },
+    ["transform"] = { files = {"transform.cpp"} },
+}
+
+for name, cfg in pairs(benchmarks) do
+    target("bench_" .. name)
+    set_group("benchmarks")
+    set_kind("binary")
+    set_languages("cxx20")
+    set_warnings("all")
+    add_deps("ige")
+    add_packages("benchmark")
+
+    for _, v in ipairs(cfg.files) do
+        add_files(v)
+    end
+end
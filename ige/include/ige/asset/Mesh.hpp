@@ -1,6 +1,7 @@
 #ifndef AC864DC3_F356_4B1D_9667_F631D9DB3AEB
 #define AC864DC3_F356_4B1D_9667_F631D9DB3AEB
 
+#include "ige/core/Bounds.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -49,6 +50,16 @@ struct Mesh {
     std::optional<Attribute> attr_weights() const;
     Topology topology() const;
 
+    /**
+     * @brief Bounding box of the vertex positions, in model space.
+     */
+    const core::Aabb& bounds() const;
+
+    /**
+     * @brief Bounding sphere of the vertex positions, in model space.
+     */
+    const core::BoundingSphere& bounding_sphere() const;
+
 private:
     std::vector<Buffer> m_buffers;
     std::vector<std::uint32_t> m_index_buffer;
@@ -58,6 +69,10 @@ private:
     std::optional<Attribute> m_attr_joints;
     std::optional<Attribute> m_attr_weights;
     Topology m_topology;
+    core::Aabb m_bounds;
+    core::BoundingSphere m_bounding_sphere;
+
+    void compute_bounds();
 };
 
 class Mesh::Builder {
@@ -15,13 +15,38 @@
 
 namespace ige::core {
 
+/**
+ * @brief Resource of the render world giving extract systems access to the
+ * simulation world.
+ */
+class MainWorld {
+public:
+    MainWorld(ecs::World&);
+
+    ecs::World& get() const;
+
+private:
+    ecs::World* m_world;
+};
+
 class App {
 private:
     core::StateMachine m_state_machine;
     ecs::World m_world;
+    ecs::World m_render_world;
     ecs::Schedule m_startup;
     ecs::Schedule m_update;
+    ecs::Schedule m_extract;
+    ecs::Schedule m_begin_frame;
+    ecs::Schedule m_render;
+    ecs::Schedule m_present;
+    ecs::Schedule m_render_cleanup;
     ecs::Schedule m_cleanup;
+    bool m_pipelined = false;
+
+    void extract();
+    void render();
+    void run_pipelined();
 
 public:
     class Builder;
@@ -37,8 +62,14 @@ public:
     private:
         ecs::Schedule::Builder m_startup;
         ecs::Schedule::Builder m_update;
+        ecs::Schedule::Builder m_extract;
+        ecs::Schedule::Builder m_begin_frame;
+        ecs::Schedule::Builder m_render;
+        ecs::Schedule::Builder m_present;
+        ecs::Schedule::Builder m_render_cleanup;
         ecs::Schedule::Builder m_cleanup;
         ecs::Resources m_res;
+        bool m_pipelined = false;
 
     public:
         App::Builder& add_plugin(const Plugin&);
@@ -50,6 +81,44 @@ public:
         App::Builder& add_cleanup_system(std::unique_ptr<ecs::System>) &;
         App::Builder add_cleanup_system(std::unique_ptr<ecs::System>) &&;
 
+        /**
+         * @brief Add a system copying data from the simulation world (see
+         * `MainWorld`) to the render world, once per frame.
+         */
+        App::Builder& add_extract_system(std::unique_ptr<ecs::System>) &;
+        App::Builder add_extract_system(std::unique_ptr<ecs::System>) &&;
+
+        /**
+         * @brief Add a system preparing the render world for drawing (e.g.
+         * making the graphics context current), before every render system.
+         */
+        App::Builder& add_begin_frame_system(std::unique_ptr<ecs::System>) &;
+        App::Builder add_begin_frame_system(std::unique_ptr<ecs::System>) &&;
+
+        /**
+         * @brief Add a system running on the render world, after extraction.
+         */
+        App::Builder& add_render_system(std::unique_ptr<ecs::System>) &;
+        App::Builder add_render_system(std::unique_ptr<ecs::System>) &&;
+
+        /**
+         * @brief Add a system presenting the frame, after every render system.
+         */
+        App::Builder& add_present_system(std::unique_ptr<ecs::System>) &;
+        App::Builder add_present_system(std::unique_ptr<ecs::System>) &&;
+        App::Builder& add_render_cleanup_system(std::unique_ptr<ecs::System>) &;
+        App::Builder add_render_cleanup_system(std::unique_ptr<ecs::System>) &&;
+
+        /**
+         * @brief Render frame N on a dedicated thread while the simulation of
+         * frame N+1 runs.
+         *
+         * Render systems then run on another thread than every other system.
+         * They must only access the render world.
+         */
+        App::Builder& set_pipelined(bool pipelined = true) &;
+        App::Builder set_pipelined(bool pipelined = true) &&;
+
         template <ecs::Resource R>
         App::Builder& insert(R res)
         {
@@ -74,6 +143,13 @@ public:
                 m_cleanup.build());
             m_res = ecs::Resources();
 
+            app.m_extract = m_extract.build();
+            app.m_begin_frame = m_begin_frame.build();
+            app.m_render = m_render.build();
+            app.m_present = m_present.build();
+            app.m_render_cleanup = m_render_cleanup.build();
+            app.m_pipelined = m_pipelined;
+
             app.state_machine().push<S>(std::forward<Args>(args)...);
             app.run();
         }
@@ -86,6 +162,9 @@ public:
     ecs::World& world();
     const ecs::World& world() const;
 
+    ecs::World& render_world();
+    const ecs::World& render_world() const;
+
     core::StateMachine& state_machine();
     const core::StateMachine& state_machine() const;
 
@@ -0,0 +1,127 @@
+#ifndef C557EA9C_D0F7_4CD0_A7E1_F14CB7AAB9B0
+#define C557EA9C_D0F7_4CD0_A7E1_F14CB7AAB9B0
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+namespace ige::core {
+
+struct BoundingSphere;
+struct Ray;
+
+/**
+ * @brief Axis-aligned bounding box.
+ */
+struct Aabb {
+    glm::vec3 min { 0.0f };
+    glm::vec3 max { 0.0f };
+
+    glm::vec3 center() const;
+
+    /**
+     * @brief Get the half size of the box along each axis.
+     */
+    glm::vec3 extents() const;
+
+    /**
+     * @brief Smallest box containing this one once transformed by `m`.
+     *
+     * `m` must be an affine transformation.
+     */
+    Aabb transformed(const glm::mat4& m) const;
+
+    /**
+     * @brief Smallest box containing both this one and `other`.
+     */
+    Aabb merged(const Aabb& other) const;
+
+    /**
+     * @brief Grow the box by `margin` on every side.
+     */
+    Aabb inflated(glm::vec3 margin) const;
+
+    float surface_area() const;
+
+    bool contains(const Aabb&) const;
+    bool intersects(const Aabb&) const;
+    bool intersects(const BoundingSphere&) const;
+
+    /**
+     * @brief Check if the ray hits the box before `max_distance` (in units of
+     * the ray's direction).
+     */
+    bool intersects(const Ray&, float max_distance) const;
+
+    bool operator==(const Aabb&) const = default;
+};
+
+struct BoundingSphere {
+    glm::vec3 center { 0.0f };
+    float radius = 0.0f;
+
+    /**
+     * @brief Smallest sphere containing this one once transformed by `m`.
+     *
+     * `m` must be an affine transformation. Non-uniform scales make the sphere
+     * grow along its largest axis.
+     */
+    BoundingSphere transformed(const glm::mat4& m) const;
+
+    /**
+     * @brief Rectangle covering the sphere once projected by `projection`, as
+     * (min x, min y, max x, max y) in normalized device coordinates.
+     *
+     * The sphere must be in view space. The rectangle is clamped to the
+     * screen, and covers all of it when the sphere reaches behind the camera.
+     */
+    glm::vec4 screen_rect(const glm::mat4& projection) const;
+
+    bool operator==(const BoundingSphere&) const = default;
+};
+
+struct Ray {
+    glm::vec3 origin { 0.0f };
+    glm::vec3 direction { 0.0f, 0.0f, -1.0f };
+};
+
+/**
+ * @brief Volume seen by a camera, as six planes facing inwards.
+ */
+struct Frustum {
+    // (normal, distance): a point `p` is inside when `dot(normal, p) +
+    // distance >= 0` for all planes
+    glm::vec4 planes[6];
+
+    /**
+     * @brief Extract the planes of a projection (or view-projection) matrix,
+     * in OpenGL clip space.
+     */
+    static Frustum from_matrix(const glm::mat4& view_projection);
+
+    bool intersects(const Aabb&) const;
+    bool intersects(const BoundingSphere&) const;
+
+    /**
+     * @brief Test many boxes at once (4 at a time when SSE is available),
+     * setting `visible[i]` to `intersects(boxes[i])`.
+     *
+     * `visible` must be at least as large as `boxes`.
+     *
+     * @return The number of boxes intersecting the frustum.
+     */
+    std::size_t cull(
+        std::span<const Aabb> boxes, std::span<std::uint8_t> visible) const;
+
+    /**
+     * @brief Check if the box is entirely inside the frustum.
+     */
+    bool contains(const Aabb&) const;
+};
+
+}
+
+#endif /* C557EA9C_D0F7_4CD0_A7E1_F14CB7AAB9B0 */
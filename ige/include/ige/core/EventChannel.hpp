@@ -1,13 +1,14 @@
 #ifndef DC695F60_BA9B_40DB_A265_378CD6D4D5E7
 #define DC695F60_BA9B_40DB_A265_378CD6D4D5E7
 
+#include <algorithm>
+#include <array>
 #include <concepts>
 #include <cstddef>
-#include <deque>
-#include <functional>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <optional>
-#include <unordered_map>
+#include <span>
 #include <vector>
 
 namespace ige::core {
@@ -15,139 +16,321 @@ namespace ige::core {
 template <typename E>
 concept Event = std::movable<E>;
 
+/**
+ * @brief Broadcast channel: every event pushed is seen by all subscriptions
+ * that existed at the time it was pushed.
+ *
+ * Events are stored in a growable ring buffer and identified by a monotonic
+ * sequence number. Each subscription is a slot holding the sequence number of
+ * the next event it will read. Events older than every cursor are reclaimed
+ * when the buffer is full, before it grows.
+ */
 template <Event E>
 class EventChannel {
+public:
+    /**
+     * @brief Pending events of a subscription, in order.
+     *
+     * The events may wrap around the end of the ring buffer, in which case
+     * they are split into two spans.
+     */
+    using Batch = std::array<std::span<const E>, 2>;
+
 private:
-    using Cursor = std::size_t;
-    using Handle = std::size_t;
+    using Sequence = std::uint64_t;
 
-    struct ChannelGuard {
-    };
+    static constexpr Sequence FREE_SLOT = std::numeric_limits<Sequence>::max();
+    static constexpr std::size_t MIN_CAPACITY = 16;
 
-    std::shared_ptr<ChannelGuard> m_channel_guard;
-    std::deque<E> m_buffer;
-    std::unordered_map<Handle, Cursor> m_sub_handles;
-    std::size_t m_subs_at_zero = 0;
+    // lives on the heap so that subscriptions survive the channel being moved
+    struct Buffer {
+        // ring buffer, its capacity is always zero or a power of two
+        std::allocator<E> m_allocator;
+        E* m_events = nullptr;
+        std::size_t m_capacity = 0;
 
-    Handle make_handle()
-    {
-        Handle handle = 0;
+        // sequence number of the oldest event in the buffer
+        Sequence m_head = 0;
+
+        // sequence number of the next event to be pushed
+        Sequence m_tail = 0;
+
+        // cursor of every subscription (FREE_SLOT for unused slots)
+        std::vector<Sequence> m_cursors;
+        std::vector<std::size_t> m_free_slots;
+        std::size_t m_sub_count = 0;
 
-        while (m_sub_handles.contains(handle)) {
-            handle++;
+        std::size_t make_slot()
+        {
+            std::size_t slot = m_cursors.size();
+
+            if (m_free_slots.empty()) {
+                m_cursors.push_back(m_tail);
+            } else {
+                slot = m_free_slots.back();
+                m_free_slots.pop_back();
+                m_cursors[slot] = m_tail;
+            }
+
+            m_sub_count++;
+            return slot;
         }
 
-        m_sub_handles.emplace(handle, m_buffer.size());
-        m_subs_at_zero += m_buffer.empty();
-        return handle;
-    }
+        void free_slot(std::size_t slot)
+        {
+            m_cursors[slot] = FREE_SLOT;
+            m_free_slots.push_back(slot);
+            m_sub_count--;
 
-    void free_handle(Handle handle)
-    {
-        auto iter = m_sub_handles.find(handle);
+            if (m_sub_count == 0) {
+                reclaim(m_tail);
+            }
+        }
 
-        if (iter != m_sub_handles.end()) {
-            m_subs_at_zero -= iter->second == 0;
-            m_sub_handles.erase(iter);
+        std::size_t index_of(Sequence seq) const
+        {
+            return static_cast<std::size_t>(seq) & (m_capacity - 1);
         }
-    }
 
-    void pop_unreachable_events()
-    {
-        while (m_subs_at_zero == 0) {
-            m_buffer.pop_front();
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(m_tail - m_head);
+        }
 
-            for (auto& [k, v] : m_sub_handles) {
-                v--;
-                m_subs_at_zero += v == 0;
+        void reclaim(Sequence until)
+        {
+            for (; m_head < until; m_head++) {
+                std::destroy_at(m_events + index_of(m_head));
             }
         }
-    }
 
-    const E* read_event(Handle handle)
-    {
-        auto iter = m_sub_handles.find(handle);
+        void reclaim_unreachable_events()
+        {
+            Sequence min_cursor = m_tail;
+
+            for (Sequence cursor : m_cursors) {
+                min_cursor = std::min(min_cursor, cursor);
+            }
+
+            reclaim(min_cursor);
+        }
 
-        if (iter != m_sub_handles.end()) {
-            Cursor& cur = iter->second;
+        void grow(std::size_t capacity)
+        {
+            E* events = m_allocator.allocate(capacity);
 
-            if (cur < m_buffer.size()) {
-                const E& event = m_buffer[cur];
+            for (Sequence seq = m_head; seq < m_tail; seq++) {
+                E* event = m_events + index_of(seq);
 
-                m_subs_at_zero -= cur == 0;
-                cur++;
+                std::construct_at(
+                    events + (static_cast<std::size_t>(seq) & (capacity - 1)),
+                    std::move(*event));
+                std::destroy_at(event);
+            }
 
-                return &event;
+            if (m_events) {
+                m_allocator.deallocate(m_events, m_capacity);
             }
+
+            m_events = events;
+            m_capacity = capacity;
         }
 
-        return nullptr;
-    }
+        // make sure `count` more events can be pushed
+        void make_room(std::size_t count)
+        {
+            if (m_capacity - size() >= count) {
+                return;
+            }
+
+            reclaim_unreachable_events();
+
+            std::size_t capacity = std::max(MIN_CAPACITY, m_capacity);
+            while (capacity - size() < count) {
+                capacity *= 2;
+            }
+
+            if (capacity != m_capacity) {
+                grow(capacity);
+            }
+        }
+
+        const E* read_event(std::size_t slot)
+        {
+            Sequence& cursor = m_cursors[slot];
+
+            if (cursor < m_tail) {
+                return m_events + index_of(cursor++);
+            }
+
+            return nullptr;
+        }
+
+        Batch read_events(std::size_t slot)
+        {
+            Sequence& cursor = m_cursors[slot];
+            std::size_t count = static_cast<std::size_t>(m_tail - cursor);
+
+            if (count == 0) {
+                return {};
+            }
+
+            std::size_t start = index_of(cursor);
+            std::size_t first = std::min(count, m_capacity - start);
+
+            cursor = m_tail;
+            return {
+                std::span<const E>(m_events + start, first),
+                std::span<const E>(m_events, count - first),
+            };
+        }
+
+        Buffer() = default;
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        ~Buffer()
+        {
+            reclaim(m_tail);
+
+            if (m_events) {
+                m_allocator.deallocate(m_events, m_capacity);
+            }
+        }
+
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            if (m_sub_count == 0) {
+                return;
+            }
+
+            make_room(1);
+            std::construct_at(
+                m_events + index_of(m_tail), std::forward<Args>(args)...);
+            m_tail++;
+        }
+
+        void push_batch(std::span<const E> events)
+        {
+            if (m_sub_count == 0) {
+                return;
+            }
+
+            make_room(events.size());
+
+            for (const E& event : events) {
+                std::construct_at(m_events + index_of(m_tail), event);
+                m_tail++;
+            }
+        }
+    };
+
+    std::shared_ptr<Buffer> m_buffer;
 
 public:
     class Subscription {
     public:
         Subscription(EventChannel& channel)
-            : m_channel_guard(channel.m_channel_guard)
-            , m_channel(channel)
-            , m_handle(channel.make_handle())
+            : m_guard(channel.m_buffer)
+            , m_buffer(channel.m_buffer.get())
+            , m_slot(m_buffer->make_slot())
         {
         }
 
         Subscription(const Subscription& other)
-            : Subscription(other.m_channel.get())
+            : m_guard(other.m_guard)
+            , m_buffer(other.m_buffer)
+            , m_slot(0)
         {
+            if (m_buffer && !m_guard.expired()) {
+                m_slot = m_buffer->make_slot();
+            } else {
+                m_buffer = nullptr;
+            }
         }
 
         Subscription(Subscription&& other)
-            : m_channel_guard(other.m_channel_guard)
-            , m_channel(other.m_channel)
-            , m_handle(other.m_handle)
+            : m_guard(std::move(other.m_guard))
+            , m_buffer(other.m_buffer)
+            , m_slot(other.m_slot)
         {
-            other.m_moved = true;
+            other.m_buffer = nullptr;
         }
 
         Subscription& operator=(Subscription&& rhs)
         {
-            if (m_moved) {
-                m_channel.get().free_handle(m_handle);
+            if (this != &rhs) {
+                release();
+                m_guard = std::move(rhs.m_guard);
+                m_buffer = rhs.m_buffer;
+                m_slot = rhs.m_slot;
+                rhs.m_buffer = nullptr;
             }
-            m_channel_guard = rhs.m_channel_guard;
-            m_channel = rhs.m_channel;
-            m_handle = rhs.m_handle;
-            m_moved = false;
-            rhs.m_moved = true;
+
             return *this;
         }
 
         ~Subscription()
         {
-            if (!m_moved && !m_channel_guard.expired()) {
-                m_channel.get().free_handle(m_handle);
-            }
+            release();
         }
 
+        /**
+         * @brief Read the next event.
+         *
+         * The returned pointer is valid until the next event is pushed.
+         *
+         * @return A pointer to the event, or nullptr if there is none.
+         */
         const E* next_event()
         {
-            if (!m_channel_guard.expired()) {
-                return m_channel.get().read_event(m_handle);
+            if (m_buffer && !m_guard.expired()) {
+                return m_buffer->read_event(m_slot);
             } else {
                 return nullptr;
             }
         }
 
+        /**
+         * @brief Read all pending events at once.
+         *
+         * The returned spans are valid until the next event is pushed.
+         *
+         * @return The pending events, split in at most two spans.
+         */
+        Batch drain()
+        {
+            if (m_buffer && !m_guard.expired()) {
+                return m_buffer->read_events(m_slot);
+            } else {
+                return {};
+            }
+        }
+
     private:
-        std::weak_ptr<ChannelGuard> m_channel_guard;
-        std::reference_wrapper<EventChannel> m_channel;
-        Handle m_handle;
-        bool m_moved = false;
+        std::weak_ptr<Buffer> m_guard;
+        Buffer* m_buffer;
+        std::size_t m_slot;
+
+        void release()
+        {
+            if (m_buffer && !m_guard.expired()) {
+                m_buffer->free_slot(m_slot);
+            }
+
+            m_buffer = nullptr;
+        }
     };
 
     EventChannel()
+        : m_buffer(std::make_shared<Buffer>())
     {
-        m_channel_guard = std::make_shared<ChannelGuard>();
     }
 
+    EventChannel(EventChannel&&) = default;
+    EventChannel& operator=(EventChannel&&) = default;
+
     Subscription subscribe()
     {
         return Subscription(*this);
@@ -155,19 +338,23 @@ public:
 
     void push(E event)
     {
-        emplace(std::move(event));
+        m_buffer->emplace(std::move(event));
     }
 
     template <typename... Args>
         requires std::constructible_from<E, Args...>
     void emplace(Args&&... args)
     {
-        if (m_sub_handles.empty()) {
-            return;
-        }
+        m_buffer->emplace(std::forward<Args>(args)...);
+    }
 
-        pop_unreachable_events();
-        m_buffer.emplace_back(std::forward<Args>(args)...);
+    /**
+     * @brief Push several events at once.
+     */
+    void push_batch(std::span<const E> events)
+        requires std::copy_constructible<E>
+    {
+        m_buffer->push_batch(events);
     }
 };
 
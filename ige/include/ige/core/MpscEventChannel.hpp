@@ -0,0 +1,290 @@
+#ifndef B646F4E7_5901_4429_B3D6_31B6B06CF3C6
+#define B646F4E7_5901_4429_B3D6_31B6B06CF3C6
+
+#include "EventChannel.hpp"
+#include "ige/ecs/World.hpp"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace ige::core {
+
+/**
+ * @brief Channel that any thread can push events into.
+ *
+ * Events are queued in a lock-free multiple-producer single-consumer queue,
+ * and moved into a regular `EventChannel` by `flush`, which must only be
+ * called from a single thread at a time (usually the main thread, once per
+ * frame). Other threads push through a `Publisher`.
+ *
+ * Queue nodes are recycled: once enough of them went through the queue,
+ * pushing an event doesn't allocate anymore.
+ */
+template <Event E>
+class MpscEventChannel {
+private:
+    struct Node {
+        std::atomic<Node*> next = nullptr;
+        std::optional<E> event;
+
+        // next node of a free list
+        Node* next_free = nullptr;
+    };
+
+    static void delete_free_list(Node* node)
+    {
+        while (node) {
+            Node* next = node->next_free;
+
+            delete node;
+            node = next;
+        }
+    }
+
+    // intrusive queue with a stub node, after Dmitry Vyukov's MPSC queue
+    class Queue {
+    public:
+        Queue()
+            : m_head(new Node)
+            , m_tail(m_head.load(std::memory_order_relaxed))
+        {
+        }
+
+        Queue(const Queue&) = delete;
+        Queue& operator=(const Queue&) = delete;
+
+        ~Queue()
+        {
+            while (m_tail) {
+                Node* next = m_tail->next.load(std::memory_order_relaxed);
+
+                delete m_tail;
+                m_tail = next;
+            }
+
+            delete_free_list(m_free.load(std::memory_order_acquire));
+            delete_free_list(m_spare);
+        }
+
+        // `cache` is a free list owned by the calling thread, refilled with
+        // every free node at once: taking a single node from the shared list
+        // wouldn't be safe without locks (ABA problem)
+        template <typename... Args>
+        void emplace(Node*& cache, Args&&... args)
+        {
+            if (!cache) {
+                cache = m_free.exchange(nullptr, std::memory_order_acquire);
+            }
+
+            Node* node = cache ? cache : new Node;
+
+            if (cache) {
+                cache = node->next_free;
+                node->next_free = nullptr;
+                node->next.store(nullptr, std::memory_order_relaxed);
+            }
+
+            node->event.emplace(std::forward<Args>(args)...);
+
+            Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // give a free list back to every thread
+        void release(Node* first)
+        {
+            if (!first) {
+                return;
+            }
+
+            Node* last = first;
+
+            while (last->next_free) {
+                last = last->next_free;
+            }
+
+            Node* top = m_free.load(std::memory_order_relaxed);
+
+            do {
+                last->next_free = top;
+            } while (!m_free.compare_exchange_weak(
+                top, first, std::memory_order_release,
+                std::memory_order_relaxed));
+        }
+
+        // pop the events pushed before the call, events pushed meanwhile are
+        // left for the next one
+        template <typename F>
+        std::size_t drain(F&& f)
+        {
+            Node* last = m_head.load(std::memory_order_acquire);
+            std::size_t count = 0;
+
+            while (m_tail != last) {
+                Node* next = m_tail->next.load(std::memory_order_acquire);
+
+                // a producer is in the middle of a push: the event will be
+                // popped by the next call
+                if (!next) {
+                    break;
+                }
+
+                f(std::move(*next->event));
+                next->event.reset();
+
+                m_tail->next_free = m_spare;
+                m_spare = m_tail;
+                m_tail = next;
+                count++;
+            }
+
+            // hand recycled nodes over to producers once they ran out
+            if (m_spare && !m_free.load(std::memory_order_relaxed)) {
+                release(m_spare);
+                m_spare = nullptr;
+            }
+
+            return count;
+        }
+
+        // free list of the consuming thread
+        Node*& spare()
+        {
+            return m_spare;
+        }
+
+    private:
+        std::atomic<Node*> m_head;
+        Node* m_tail;
+        std::atomic<Node*> m_free = nullptr;
+        Node* m_spare = nullptr;
+    };
+
+    std::shared_ptr<Queue> m_queue;
+
+public:
+    /**
+     * @brief Handle to push events into the channel from another thread.
+     *
+     * It keeps the queue alive, so it can outlive the channel. A publisher
+     * must only be used by one thread at a time, copy it to share it.
+     */
+    class Publisher {
+    public:
+        Publisher(const Publisher& other)
+            : m_queue(other.m_queue)
+        {
+        }
+
+        Publisher(Publisher&& other)
+            : m_queue(std::move(other.m_queue))
+            , m_cache(std::exchange(other.m_cache, nullptr))
+        {
+        }
+
+        Publisher& operator=(Publisher other)
+        {
+            std::swap(m_queue, other.m_queue);
+            std::swap(m_cache, other.m_cache);
+            return *this;
+        }
+
+        ~Publisher()
+        {
+            if (m_queue) {
+                m_queue->release(m_cache);
+            }
+        }
+
+        void push(E event)
+        {
+            emplace(std::move(event));
+        }
+
+        template <typename... Args>
+            requires std::constructible_from<E, Args...>
+        void emplace(Args&&... args)
+        {
+            m_queue->emplace(m_cache, std::forward<Args>(args)...);
+        }
+
+    private:
+        friend class MpscEventChannel;
+
+        std::shared_ptr<Queue> m_queue;
+        Node* m_cache = nullptr;
+
+        Publisher(std::shared_ptr<Queue> queue)
+            : m_queue(std::move(queue))
+        {
+        }
+    };
+
+    MpscEventChannel()
+        : m_queue(std::make_shared<Queue>())
+    {
+    }
+
+    // there must be a single consumer
+    MpscEventChannel(MpscEventChannel&&) = default;
+    MpscEventChannel& operator=(MpscEventChannel&&) = default;
+
+    Publisher publisher() const
+    {
+        return Publisher(m_queue);
+    }
+
+    /**
+     * @brief Push an event from the consuming thread.
+     */
+    void push(E event)
+    {
+        emplace(std::move(event));
+    }
+
+    template <typename... Args>
+        requires std::constructible_from<E, Args...>
+    void emplace(Args&&... args)
+    {
+        m_queue->emplace(m_queue->spare(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Move the events queued so far into a regular channel, in push
+     * order for each producer.
+     *
+     * Events pushed while flushing are left for the next flush, so that busy
+     * producers can't keep the consumer flushing forever.
+     *
+     * @return The number of events moved.
+     */
+    std::size_t flush(EventChannel<E>& channel)
+    {
+        return m_queue->drain(
+            [&](E&& event) { channel.push(std::move(event)); });
+    }
+};
+
+/**
+ * @brief System flushing `MpscEventChannel<E>` into `EventChannel<E>`.
+ *
+ * It does nothing if either resource is missing.
+ */
+template <Event E>
+void flush_event_channel(ecs::World& world)
+{
+    auto mpsc = world.get<MpscEventChannel<E>>();
+    auto channel = world.get<EventChannel<E>>();
+
+    if (mpsc && channel) {
+        mpsc->flush(*channel);
+    }
+}
+
+}
+
+#endif /* B646F4E7_5901_4429_B3D6_31B6B06CF3C6 */
@@ -0,0 +1,34 @@
+#ifndef A4D753B4_4C61_4B5D_B51B_AC545B41C6E5
+#define A4D753B4_4C61_4B5D_B51B_AC545B41C6E5
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ige::core {
+
+/**
+ * @brief Stable LSD radix sort of 64-bit keys, each carrying a 32-bit value.
+ *
+ * Scratch buffers are kept between calls: reuse the same instance to avoid
+ * allocating. Bytes that are the same in every key are skipped, so sorting
+ * keys that only use a few bits is faster.
+ */
+class RadixSort {
+public:
+    /**
+     * @brief Sort `keys` in ascending order, moving `values[i]` along with
+     * `keys[i]`.
+     *
+     * Both spans must have the same size.
+     */
+    void sort(std::span<std::uint64_t> keys, std::span<std::uint32_t> values);
+
+private:
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint32_t> m_values;
+};
+
+}
+
+#endif /* A4D753B4_4C61_4B5D_B51B_AC545B41C6E5 */
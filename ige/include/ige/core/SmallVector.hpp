@@ -0,0 +1,211 @@
+#ifndef CAA7B62F_73F2_49BF_A491_BE837C178680
+#define CAA7B62F_73F2_49BF_A491_BE837C178680
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ige::core {
+
+/**
+ * @brief Vector storing up to `N` elements inline, without any allocation.
+ *
+ * It only falls back to the heap when it grows past `N` elements. Elements
+ * must be trivially copyable, so they can be relocated with a plain copy.
+ */
+template <typename T, std::size_t N>
+    requires(N > 0) && std::is_trivially_copyable_v<T>
+class SmallVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    SmallVector(const SmallVector& other)
+    {
+        *this = other;
+    }
+
+    SmallVector(SmallVector&& other)
+    {
+        *this = std::move(other);
+    }
+
+    ~SmallVector()
+    {
+        release();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other.m_size);
+            std::uninitialized_copy(other.begin(), other.end(), data());
+            m_size = other.m_size;
+        }
+
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (other.is_inline()) {
+            *this = static_cast<const SmallVector&>(other);
+        } else {
+            // steal the heap buffer
+            release();
+            m_heap = std::exchange(other.m_heap, nullptr);
+            m_size = other.m_size;
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+
+        other.m_size = 0;
+        return *this;
+    }
+
+    void push_back(const T& value)
+    {
+        if (m_size == m_capacity) {
+            reserve(m_capacity * 2);
+        }
+
+        std::construct_at(data() + m_size, value);
+        m_size++;
+    }
+
+    void pop_back()
+    {
+        m_size--;
+    }
+
+    T& back()
+    {
+        return data()[m_size - 1];
+    }
+
+    const T& back() const
+    {
+        return data()[m_size - 1];
+    }
+
+    /**
+     * @brief Remove the element at `pos`, keeping the order of the others.
+     *
+     * @return An iterator to the element following the removed one.
+     */
+    iterator erase(const_iterator pos)
+    {
+        iterator it = begin() + (pos - begin());
+
+        std::copy(it + 1, end(), it);
+        m_size--;
+        return it;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= m_capacity) {
+            return;
+        }
+
+        T* heap = std::allocator<T>().allocate(capacity);
+
+        std::uninitialized_copy(begin(), end(), heap);
+        release();
+        m_heap = heap;
+        m_capacity = capacity;
+    }
+
+    void clear()
+    {
+        m_size = 0;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    T* data()
+    {
+        return is_inline() ? reinterpret_cast<T*>(m_inline) : m_heap;
+    }
+
+    const T* data() const
+    {
+        return is_inline() ? reinterpret_cast<const T*>(m_inline) : m_heap;
+    }
+
+    T& operator[](std::size_t index)
+    {
+        return data()[index];
+    }
+
+    const T& operator[](std::size_t index) const
+    {
+        return data()[index];
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + m_size;
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + m_size;
+    }
+
+private:
+    alignas(T) std::byte m_inline[N * sizeof(T)];
+    T* m_heap = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = N;
+
+    bool is_inline() const
+    {
+        return m_heap == nullptr;
+    }
+
+    void release()
+    {
+        if (m_heap) {
+            std::allocator<T>().deallocate(m_heap, m_capacity);
+            m_heap = nullptr;
+            m_capacity = N;
+        }
+    }
+};
+
+}
+
+#endif /* CAA7B62F_73F2_49BF_A491_BE837C178680 */
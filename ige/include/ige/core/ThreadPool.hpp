@@ -0,0 +1,56 @@
+#ifndef D6D4CF2A_9A6E_4D44_9357_A44265DB387A
+#define D6D4CF2A_9A6E_4D44_9357_A44265DB387A
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ige::core {
+
+/**
+ * @brief Fixed set of worker threads running data-parallel loops.
+ *
+ * Systems share it as a resource (`world.get_or_emplace<ThreadPool>()`).
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Create a pool using all hardware threads (the calling thread
+     * counts as one of them).
+     */
+    ThreadPool();
+
+    /**
+     * @brief Create a pool with `threads` threads, including the calling one.
+     */
+    explicit ThreadPool(std::size_t threads);
+
+    ThreadPool(ThreadPool&&);
+    ThreadPool& operator=(ThreadPool&&);
+    ~ThreadPool();
+
+    /**
+     * @brief Number of threads running jobs, including the calling thread.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Call `job(i)` for every `i` in `[0, count)`, spread across all
+     * threads, and wait for all of them to return.
+     *
+     * The calling thread runs jobs too. If jobs throw, the first exception is
+     * rethrown once all jobs are done. Jobs must not call `for_each` on the
+     * same pool.
+     */
+    void
+    for_each(std::size_t count, const std::function<void(std::size_t)>& job);
+
+private:
+    struct Shared;
+
+    std::unique_ptr<Shared> m_shared;
+};
+
+}
+
+#endif /* D6D4CF2A_9A6E_4D44_9357_A44265DB387A */
@@ -1,8 +1,10 @@
 #ifndef F171BC61_6D7C_4555_A4C6_5073CCB074F3
 #define F171BC61_6D7C_4555_A4C6_5073CCB074F3
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <unordered_map>
@@ -13,6 +15,7 @@ template <typename V>
 class MapStorage {
 private:
     std::unordered_map<std::size_t, V> m_data;
+    std::uint64_t m_version = 0;
 
 public:
     using Iterator = std::unordered_map<std::size_t, V>::iterator;
@@ -21,12 +24,14 @@ public:
 
     MapStorage(MapStorage&& other)
         : m_data(std::move(other.m_data))
+        , m_version(other.m_version)
     {
     }
 
     MapStorage& operator=(MapStorage&& rhs)
     {
         m_data = std::move(rhs.m_data);
+        m_version = std::max(m_version, rhs.m_version) + 1;
         return *this;
     }
 
@@ -38,6 +43,7 @@ public:
         m_data.emplace(
             std::piecewise_construct, std::forward_as_tuple(key),
             std::forward_as_tuple(std::forward<Args>(args)...));
+        m_version++;
     }
 
     const V* get(std::size_t key) const
@@ -70,12 +76,23 @@ public:
             V opt = std::move(it->second);
 
             m_data.erase(it);
+            m_version++;
             return { std::move(opt) };
         } else {
             return std::nullopt;
         }
     }
 
+    /**
+     * @brief Number of times components were set or removed.
+     *
+     * Modifying a component in place doesn't change the version.
+     */
+    std::uint64_t version() const
+    {
+        return m_version;
+    }
+
     Iterator begin()
     {
         return m_data.begin();
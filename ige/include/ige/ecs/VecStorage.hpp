@@ -1,7 +1,9 @@
 #ifndef DB322AB1_C834_42D3_82D6_5F31BCC83A33
 #define DB322AB1_C834_42D3_82D6_5F31BCC83A33
 
+#include <algorithm>
 #include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <optional>
@@ -14,6 +16,7 @@ template <typename V>
 class VecStorage {
 private:
     std::vector<std::optional<V>> m_data;
+    std::uint64_t m_version = 0;
 
 public:
     class Iterator {
@@ -93,12 +96,14 @@ public:
 
     VecStorage(VecStorage&& other)
         : m_data(std::move(other.m_data))
+        , m_version(other.m_version)
     {
     }
 
     VecStorage& operator=(VecStorage&& rhs)
     {
         m_data = std::move(rhs.m_data);
+        m_version = std::max(m_version, rhs.m_version) + 1;
         return *this;
     }
 
@@ -111,6 +116,7 @@ public:
         }
 
         m_data[idx].emplace(std::forward<Args>(args)...);
+        m_version++;
     }
 
     const V* get(std::size_t idx) const
@@ -143,9 +149,23 @@ public:
             m_data[idx].swap(element);
         }
 
+        if (element) {
+            m_version++;
+        }
+
         return element;
     }
 
+    /**
+     * @brief Number of times components were set or removed.
+     *
+     * Modifying a component in place doesn't change the version.
+     */
+    std::uint64_t version() const
+    {
+        return m_version;
+    }
+
     Iterator begin()
     {
         return { *this, 0 };
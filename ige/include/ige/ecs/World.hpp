@@ -40,6 +40,13 @@ public:
 
     bool exists(const EntityId&);
 
+    /**
+     * @brief Get the entity currently living at the given index, if any.
+     *
+     * This is cheaper than `exists` to check whether an entity is still alive.
+     */
+    std::optional<EntityId> entity_at(std::size_t index) const;
+
     template <Resource R>
     R& insert(R res)
     {
@@ -8,6 +8,7 @@
 #include "plugin/PhysicsPlugin.hpp"
 #include "plugin/RenderPlugin.hpp"
 #include "plugin/ScriptPlugin.hpp"
+#include "plugin/SpatialIndexPlugin.hpp"
 #include "plugin/TimePlugin.hpp"
 #include "plugin/TransformPlugin.hpp"
 #include "plugin/UiPlugin.hpp"
@@ -3,6 +3,7 @@
 
 #include "ige/core/App.hpp"
 #include "ige/core/EventChannel.hpp"
+#include "ige/core/MpscEventChannel.hpp"
 #include "ige/ecs/System.hpp"
 #include "ige/ecs/World.hpp"
 #include "input/InputManager.hpp"
@@ -20,6 +21,9 @@ public:
     {
         builder.emplace<InputManager<AxisId, ActionId>>();
         builder.emplace<ige::core::EventChannel<InputEvent>>();
+        builder.emplace<ige::core::MpscEventChannel<InputEvent>>();
+        builder.add_system(ige::ecs::System::from(
+            ige::core::flush_event_channel<InputEvent>));
         builder.add_system(ige::ecs::System::from(update_input_manager));
     }
 
@@ -6,12 +6,15 @@
 #include "ige/asset/Texture.hpp"
 #include "ige/core/App.hpp"
 #include "ige/ecs/Entity.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace ige::plugin::render {
 
@@ -27,6 +30,8 @@ struct PerspectiveCamera {
         , far(far)
     {
     }
+
+    bool operator==(const PerspectiveCamera&) const = default;
 };
 
 enum class LightType {
@@ -47,6 +52,8 @@ struct Light {
         glm::vec3 color = glm::vec3 { 1.0f });
     static Light
     directional(float intensity, glm::vec3 color = glm::vec3 { 1.0f });
+
+    bool operator==(const Light&) const = default;
 };
 
 class Visibility {
@@ -68,6 +75,13 @@ private:
     float m_global_opacity = 1.0f;
 };
 
+/**
+ * @brief Component drawing a mesh at the location of the entity's `Transform`.
+ *
+ * Entities with a `Transform` also get a `transform::WorldBounds` matching the
+ * bounds of the mesh, used to skip meshes outside of the camera's view. When
+ * the mesh is swapped in place, they are refreshed by the next update.
+ */
 struct MeshRenderer {
     asset::Mesh::Handle mesh;
     asset::Material::Handle material;
@@ -86,6 +100,8 @@ struct RectRenderer {
     RectRenderer set_fill_rgb(std::uint32_t rgb) &&;
 
     glm::vec4 fill;
+
+    bool operator==(const RectRenderer&) const = default;
 };
 
 struct ImageRenderer {
@@ -117,6 +133,97 @@ struct ImageRenderer {
     glm::vec4 borders { 1.0f / 3.0f };
     glm::vec4 tint { 1.0f };
     Mode mode = Mode::STRETCHED;
+
+    bool operator==(const ImageRenderer&) const = default;
+};
+
+/**
+ * @brief Resource of the render world (`App::render_world`) counting the meshes
+ * drawn and skipped by frustum culling during the last frame.
+ */
+struct CullingStats {
+    std::size_t visible = 0;
+    std::size_t culled = 0;
+};
+
+/**
+ * @brief Resource of the render world (`App::render_world`) counting the draw
+ * calls and the GL state changes of the last frame's geometry pass.
+ */
+struct DrawStats {
+    std::size_t draw_calls = 0;
+    std::size_t state_changes = 0;
+
+    // state changes skipped because the state was already set
+    std::size_t state_changes_avoided = 0;
+};
+
+/**
+ * @brief Render world resource timing frames on the GPU, when present.
+ *
+ * Timer queries are read a few frames after they were issued, so that waiting
+ * for their result never stalls the pipeline.
+ */
+struct GpuFrameTime {
+    // GPU time spent on the last measured frame
+    double milliseconds = 0.0;
+
+    // number of frames measured so far
+    std::size_t frames = 0;
+};
+
+/**
+ * @brief Render world resource receiving a copy of every frame drawn, when
+ * present.
+ *
+ * Pixels are tightly packed RGBA8 rows, starting from the bottom of the frame.
+ * Reading them back waits for the GPU to finish the frame: it is meant for
+ * tests comparing frames to reference images.
+ *
+ * `gl_errors` lists the OpenGL errors still pending once the frame is drawn,
+ * in every build mode. Debug builds report and clear most of them earlier.
+ */
+struct FrameReadback {
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::vector<std::uint8_t> pixels;
+    std::vector<std::string> gl_errors;
+};
+
+/**
+ * @brief Render world resource tuning the geometry (gbuffer) pass.
+ */
+struct GeometryPassOptions {
+    // fill the depth buffer first with depth-only programs, so that the
+    // gbuffer is written at most once per pixel
+    bool depth_prepass = false;
+
+    // sort meshes front to back first, instead of by GL state (then front to
+    // back): more fragments are rejected early, but fewer meshes are drawn in
+    // the same instanced draw call
+    bool front_to_back = false;
+};
+
+/**
+ * @brief Render world resource tuning the deferred light pass.
+ *
+ * Point lights only shade the part of the screen their range can reach. By
+ * default, it is covered with a quad. `SCISSOR` draws a full screen quad with
+ * a scissor test instead, for drivers where it is cheaper.
+ *
+ * When `clustered` is set, lights are instead assigned to the clusters of a
+ * grid dividing the view frustum (see `LightClusters`), and a single full
+ * screen pass shades each pixel with the lights of its cluster. This scales
+ * to many more lights.
+ */
+struct LightPassOptions {
+    enum class Bounds {
+        QUAD,
+        SCISSOR,
+    };
+
+    Bounds bounds = Bounds::QUAD;
+    bool clustered = false;
 };
 
 class RenderPlugin : public core::App::Plugin {
@@ -0,0 +1,24 @@
+#ifndef B380E555_4A53_465F_8CCC_AE1C96DB4EC4
+#define B380E555_4A53_465F_8CCC_AE1C96DB4EC4
+
+#include "ige/core/App.hpp"
+#include "spatial/SpatialIndex.hpp"
+
+namespace ige::plugin::spatial {
+
+/**
+ * @brief Keeps a `SpatialIndex` resource of every entity with a
+ * `transform::WorldBounds`.
+ *
+ * Add it after the `TransformPlugin` (and the `RenderPlugin`, which adds
+ * bounds to meshes). Moved entities are updated along with their world
+ * transform; all entities are only visited when bounds are added or removed.
+ */
+class SpatialIndexPlugin : public core::App::Plugin {
+public:
+    void plug(core::App::Builder&) const override;
+};
+
+}
+
+#endif /* B380E555_4A53_465F_8CCC_AE1C96DB4EC4 */
@@ -2,28 +2,46 @@
 #define F4DF8A5F_1CCD_443F_8D71_8A439340E94F
 
 #include "ige/core/App.hpp"
+#include "ige/core/Bounds.hpp"
+#include "ige/core/SmallVector.hpp"
 #include "ige/ecs/Entity.hpp"
 #include "ige/ecs/VecStorage.hpp"
 #include "ige/ecs/World.hpp"
+#include "transform/Affine.hpp"
+#include <cstddef>
 #include <glm/ext/quaternion_float.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <memory>
 #include <optional>
-#include <unordered_set>
 #include <vector>
 
+class TransformHierarchy;
+
+namespace ige::asset {
+struct Mesh;
+}
+
 namespace ige::plugin::transform {
 
 /**
  * @brief Component giving a parent to an entity.
+ *
+ * It can't be modified: to change the parent of an entity, replace the
+ * component (e.g. with `World::emplace_component`), so that the hierarchy
+ * sees the change.
  */
-struct Parent {
-    ecs::EntityId entity;
-
+class Parent {
+public:
     Parent(ecs::EntityId parent_entity);
 
+    ecs::EntityId entity() const;
+
     bool operator==(const Parent&) const = default;
+
+private:
+    ecs::EntityId m_entity;
 };
 
 /**
@@ -34,7 +52,7 @@ struct Parent {
  * Any modification made to it will be overwritten by the engine!
  */
 struct Children {
-    std::unordered_set<ecs::EntityId> entities;
+    core::SmallVector<ecs::EntityId, 4> entities;
 };
 
 class Transform {
@@ -45,7 +63,21 @@ private:
 
     bool m_dirty = false;
     glm::mat4 m_local_to_world { 1.0f };
-    glm::mat4 m_world_to_local { 1.0f };
+
+    // inverse of `m_local_to_world`, only computed when asked for: most
+    // transforms never need it, so it is kept out of line
+    mutable std::unique_ptr<glm::mat4> m_world_to_local;
+    mutable bool m_world_to_local_stale = true;
+
+    // set by the hierarchy: the index of our node is pushed to `m_changes`
+    // when we become dirty, so that only changed subtrees are updated
+    std::vector<std::size_t>* m_changes = nullptr;
+    std::size_t m_node = 0;
+
+    friend class ::TransformHierarchy;
+
+    void mark_dirty();
+    void set_world(const Affine& world);
 
 public:
     using Storage = ecs::VecStorage<Transform>;
@@ -54,6 +86,10 @@ public:
 
     constexpr explicit Transform() = default;
 
+    // copies aren't part of the hierarchy until it is rebuilt
+    Transform(const Transform&);
+    Transform& operator=(const Transform&);
+
     glm::vec3 translation() const;
     glm::vec3 world_translation() const;
     glm::quat rotation() const;
@@ -82,25 +118,98 @@ public:
     look_at(glm::vec3 target, glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f)) &&;
 
     void force_update(const glm::mat4& parent);
+    void force_update(const Transform& parent);
     bool needs_update() const;
 
     const glm::mat4& local_to_world() const;
+
+    /**
+     * @brief Get the inverse of `local_to_world()`.
+     *
+     * It is computed on the first call after each update, and cached. Not
+     * safe to call from multiple threads at the same time.
+     */
     const glm::mat4& world_to_local() const;
 };
 
-class RectTransform {
+/**
+ * @brief World space bounding volumes of an entity with a `Transform`.
+ *
+ * They are recomputed from the local ones along with the world transform of
+ * the entity, only when it changes: call `force_update` when inserting or
+ * replacing the component. The `RenderPlugin` adds them to entities with a
+ * `MeshRenderer`, from the bounds of their mesh.
+ */
+class WorldBounds {
 public:
+    WorldBounds(
+        core::Aabb local_aabb, core::BoundingSphere local_sphere,
+        const asset::Mesh* mesh = nullptr);
+
+    const core::Aabb& local_aabb() const;
+    const core::BoundingSphere& local_sphere() const;
+
+    /**
+     * @brief Mesh the local bounds were taken from, if any.
+     *
+     * Only used for comparison, it may have been destroyed since.
+     */
+    const asset::Mesh* mesh() const;
+
+    const core::Aabb& aabb() const;
+    const core::BoundingSphere& sphere() const;
+
+    void force_update(const glm::mat4& local_to_world);
+
+private:
+    core::Aabb m_local_aabb;
+    core::BoundingSphere m_local_sphere;
+    core::Aabb m_aabb;
+    core::BoundingSphere m_sphere;
+    const asset::Mesh* m_mesh;
+};
+
+class RectTransform {
+private:
     // bottom left corner location (in pixels)
-    glm::vec2 bounds_min { 0.0f };
+    glm::vec2 m_bounds_min { 0.0f };
 
     // top right corner location (in pixels)
-    glm::vec2 bounds_max { 0.0f };
+    glm::vec2 m_bounds_max { 0.0f };
 
     // bottom left anchor location (0..1 proportional to parent)
-    glm::vec2 anchors_min { 0.0f };
+    glm::vec2 m_anchors_min { 0.0f };
 
     // top right anchor location (0..1 proportional to parent)
-    glm::vec2 anchors_max { 1.0f };
+    glm::vec2 m_anchors_max { 1.0f };
+
+    glm::vec2 m_abs_bounds_min { 0.0f };
+    glm::vec2 m_abs_bounds_max { 0.0f };
+    float m_abs_depth = 0.0f;
+
+    // new rects have never been laid out
+    bool m_dirty = true;
+
+    // set by the hierarchy, like for `Transform`: only the subtrees of dirty
+    // rects are laid out again
+    std::vector<std::size_t>* m_changes = nullptr;
+    std::size_t m_node = 0;
+
+    friend class ::TransformHierarchy;
+
+    void mark_dirty();
+
+public:
+    RectTransform() = default;
+
+    // copies aren't part of the hierarchy until it is rebuilt
+    RectTransform(const RectTransform&);
+    RectTransform& operator=(const RectTransform&);
+
+    glm::vec2 bounds_min() const;
+    glm::vec2 bounds_max() const;
+    glm::vec2 anchors_min() const;
+    glm::vec2 anchors_max() const;
 
     RectTransform& set_bounds(glm::vec2 min, glm::vec2 max) &;
     RectTransform set_bounds(glm::vec2 min, glm::vec2 max) &&;
@@ -113,6 +222,7 @@ public:
     void force_update(
         glm::vec2 parent_abs_bounds_min, glm::vec2 parent_abs_bounds_max,
         float abs_depth);
+    bool needs_update() const;
 
     /// @brief Get the absolute position of the lower left corner.
     glm::vec2 abs_bounds_min() const;
@@ -121,11 +231,6 @@ public:
     glm::vec2 abs_bounds_max() const;
 
     float abs_depth() const;
-
-private:
-    glm::vec2 m_abs_bounds_min { 0.0f };
-    glm::vec2 m_abs_bounds_max { 0.0f };
-    float m_abs_depth = 0.0f;
 };
 
 class TransformPlugin : public core::App::Plugin {
@@ -3,6 +3,8 @@
 
 #include "ige/core/App.hpp"
 #include <cstdint>
+#include <stdexcept>
+#include <string>
 
 namespace ige::plugin::window {
 
@@ -10,6 +12,19 @@ struct WindowSettings {
     std::string title;
     std::uint32_t width;
     std::uint32_t height;
+
+    // render offscreen, without a display: no window is shown and the default
+    // framebuffer keeps its size (requires EGL, or OSMesa, at runtime)
+    bool headless = false;
+};
+
+/**
+ * @brief Thrown when `WindowSettings::headless` is set but no offscreen OpenGL
+ * context can be created, neither with an EGL pbuffer nor with OSMesa.
+ */
+class HeadlessContextError : public std::runtime_error {
+public:
+    HeadlessContextError(const std::string& reasons);
 };
 
 struct WindowInfo {
@@ -25,6 +40,34 @@ struct WindowEvent {
     WindowEventKind kind;
 };
 
+/**
+ * @brief Resource enabling the reactive mode.
+ *
+ * When present, the app sleeps until an event arrives instead of running the
+ * next frame right away, unless an update was requested. Frames are only drawn
+ * when their content changed.
+ */
+struct ReactiveMode {
+    // maximum time to sleep for, in seconds
+    double timeout = 0.5;
+
+    // set to run the next update without waiting for events (e.g. while an
+    // animation is playing), reset every frame
+    bool update_requested = true;
+};
+
+/**
+ * @brief Render world resource telling whether the current frame must be
+ * drawn.
+ *
+ * It is always true unless `ReactiveMode` is enabled. Render systems should
+ * skip drawing when it is false. Extract systems may only set it, whatever
+ * the order they run in: it is reset once the frame is presented.
+ */
+struct Redraw {
+    bool needed = true;
+};
+
 class WindowPlugin : public core::App::Plugin {
 public:
     void plug(core::App::Builder&) const override;
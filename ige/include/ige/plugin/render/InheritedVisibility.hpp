@@ -0,0 +1,66 @@
+#ifndef F2608716_F936_4EE1_A83B_E3F70AD8F173
+#define F2608716_F936_4EE1_A83B_E3F70AD8F173
+
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ige::plugin::render {
+
+/**
+ * @brief Global visibility of the entities without a `Visibility` component,
+ * inherited from their closest ancestor that has one.
+ *
+ * Only entities that differ from the default (visible and opaque) are stored:
+ * hidden ones in a bitfield, and translucent ones along with their opacity.
+ * Entities with a `Visibility` component have their own global visibility.
+ */
+class InheritedVisibility {
+public:
+    /**
+     * @brief Propagate visibility down the `TransformHierarchy`.
+     *
+     * Only the subtrees of entities with a `Visibility` are visited; the rest
+     * of the hierarchy can't inherit anything but the default. Nothing is
+     * done when neither the hierarchy, the `Visibility` storage nor any
+     * `Visibility` changed since the last update.
+     */
+    void update(ecs::World&);
+
+    bool visible(ecs::EntityId) const;
+    float opacity(ecs::EntityId) const;
+
+private:
+    struct State {
+        bool visible;
+        float opacity;
+
+        bool operator==(const State&) const = default;
+    };
+
+    // by entity index
+    std::vector<bool> m_hidden;
+    std::unordered_map<std::size_t, float> m_opacity;
+
+    // hierarchy and `Visibility` storage versions, and the local visibility
+    // of every `Visibility` (in storage order) during the last update
+    std::optional<std::pair<std::uint64_t, std::uint64_t>> m_versions;
+    std::vector<State> m_locals;
+
+    // scratch buffers, kept to avoid allocating every frame
+    std::vector<std::size_t> m_roots;
+    std::vector<State> m_states;
+    std::vector<State> m_next_locals;
+
+    bool changed(ecs::World&);
+    void set(ecs::EntityId, State);
+};
+
+}
+
+#endif /* F2608716_F936_4EE1_A83B_E3F70AD8F173 */
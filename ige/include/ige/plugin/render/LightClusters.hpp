@@ -0,0 +1,92 @@
+#ifndef C986BD79_CB1A_4253_9789_A377F269189F
+#define C986BD79_CB1A_4253_9789_A377F269189F
+
+#include "ige/core/Bounds.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ige::plugin::render {
+
+/**
+ * @brief Assigns lights to the clusters of a perspective view frustum.
+ *
+ * The screen is split in `TILES_X` by `TILES_Y` tiles, and each tile in
+ * `SLICES` depth slices growing exponentially from the near plane to the far
+ * plane. Light indices are stored cluster after cluster, so that shading a
+ * pixel only loops over the lights of its cluster.
+ *
+ * Lights are tested against the planes between tiles several at a time (with
+ * SSE when available). The test is conservative: a light may be assigned to a
+ * cluster it doesn't reach, but never the other way around.
+ */
+class LightClusters {
+public:
+    static constexpr std::size_t TILES_X = 16;
+    static constexpr std::size_t TILES_Y = 9;
+    static constexpr std::size_t SLICES = 24;
+    static constexpr std::size_t COUNT = TILES_X * TILES_Y * SLICES;
+
+    struct Cluster {
+        // range of the cluster's lights in `indices()`
+        std::uint32_t offset = 0;
+        std::uint32_t count = 0;
+    };
+
+    /**
+     * @param fov_y Vertical field of view, in radians.
+     */
+    void set_projection(float fov_y, float aspect, float near, float far);
+
+    /**
+     * @brief Assign view-space light volumes, replacing the previous ones.
+     */
+    void assign(std::span<const core::BoundingSphere> lights);
+
+    /**
+     * @brief Index of the cluster at the given tile and slice.
+     *
+     * Tiles are numbered from the bottom left corner of the screen.
+     */
+    static std::size_t index(std::size_t x, std::size_t y, std::size_t slice);
+
+    /**
+     * @brief Depth slice of a point at the given distance from the camera
+     * (along its view direction), i.e. `floor(log(depth / near) * scale)`.
+     */
+    std::size_t slice(float depth) const;
+
+    float near() const;
+    float slice_scale() const;
+
+    std::span<const Cluster> clusters() const;
+    std::span<const std::uint32_t> indices() const;
+
+private:
+    // boundaries between tiles, padded to a multiple of 4 for SIMD
+    static constexpr std::size_t COLUMN_PLANES = (TILES_X + 1 + 3) / 4 * 4;
+    static constexpr std::size_t ROW_PLANES = (TILES_Y + 1 + 3) / 4 * 4;
+
+    // planes through the camera between tiles, as the x (or y) and z
+    // components of their normal (facing right, or up)
+    std::array<float, COLUMN_PLANES> m_column_x {};
+    std::array<float, COLUMN_PLANES> m_column_z {};
+    std::array<float, ROW_PLANES> m_row_y {};
+    std::array<float, ROW_PLANES> m_row_z {};
+
+    float m_near = 0.1f;
+    float m_far = 100.0f;
+    float m_slice_scale = 0.0f;
+
+    std::vector<Cluster> m_clusters = std::vector<Cluster>(COUNT);
+    std::vector<std::uint32_t> m_indices;
+
+    // (cluster, light) pairs, reused by `assign`
+    std::vector<std::uint64_t> m_pairs;
+};
+
+}
+
+#endif /* C986BD79_CB1A_4253_9789_A377F269189F */
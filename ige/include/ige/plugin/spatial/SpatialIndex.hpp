@@ -0,0 +1,114 @@
+#ifndef A9288600_92FF_4FF6_97DE_5A99E7D5705A
+#define A9288600_92FF_4FF6_97DE_5A99E7D5705A
+
+#include "ige/core/Bounds.hpp"
+#include "ige/ecs/Entity.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ige::plugin::spatial {
+
+/**
+ * @brief Dynamic AABB tree (bounding volume hierarchy) of entities.
+ *
+ * Leaves store slightly enlarged ("fat") boxes, so that entities moving a
+ * little don't need to touch the tree at all. Entities are inserted where
+ * they increase the surface area of the tree the least, without rotations:
+ * the tree is rebuilt by `rebalance` once it gets too deep.
+ *
+ * Queries replace the content of the given vector with the entities whose
+ * (fat) box matches. Reuse the same vector to avoid allocating.
+ */
+class SpatialIndex {
+public:
+    /**
+     * @param margin Extra space around boxes, relative to their size.
+     */
+    explicit SpatialIndex(float margin = 0.1f);
+
+    /**
+     * @brief Insert an entity, or update its box if it is already in.
+     *
+     * Nothing happens if the new box is still inside the fat one.
+     */
+    void update(ecs::EntityId, const core::Aabb&);
+
+    void remove(ecs::EntityId);
+    bool contains(ecs::EntityId) const;
+    std::size_t size() const;
+
+    /**
+     * @brief Number of levels below the root (0 for a single entity).
+     */
+    std::size_t height() const;
+
+    /**
+     * @brief Check if the tree is still shallow enough to be queried
+     * efficiently.
+     */
+    bool balanced() const;
+
+    /**
+     * @brief Rebuild the tree from scratch, splitting entities in halves along
+     * the longest axis at each level.
+     */
+    void rebalance();
+
+    void query(const core::Aabb&, std::vector<ecs::EntityId>& out) const;
+    void
+    query(const core::BoundingSphere&, std::vector<ecs::EntityId>& out) const;
+    void query(const core::Frustum&, std::vector<ecs::EntityId>& out) const;
+    void query(
+        const core::Ray&, float max_distance,
+        std::vector<ecs::EntityId>& out) const;
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        core::Aabb box;
+        std::uint32_t parent = NONE;
+        std::uint32_t children[2] = { NONE, NONE };
+
+        // 0 for leaves
+        std::uint32_t height = 0;
+
+        // leaves only
+        ecs::EntityId entity { 0, 0 };
+
+        bool is_leaf() const;
+    };
+
+    float m_margin;
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_free;
+    std::uint32_t m_root = NONE;
+    std::size_t m_size = 0;
+
+    // leaf node of each entity, by entity index
+    std::vector<std::uint32_t> m_leaves;
+
+    std::uint32_t allocate();
+    void release(std::uint32_t node);
+
+    void insert_leaf(std::uint32_t leaf);
+    void remove_leaf(std::uint32_t leaf);
+
+    // update boxes and heights from `node` up to the root
+    void refit(std::uint32_t node);
+
+    // build a subtree out of the given leaves, returns its root
+    std::uint32_t build(
+        std::vector<std::uint32_t>::iterator first,
+        std::vector<std::uint32_t>::iterator last);
+
+    template <typename Test, typename Contains>
+    void traverse(
+        const Test& test, const Contains& contains,
+        std::vector<ecs::EntityId>& out) const;
+};
+
+}
+
+#endif /* A9288600_92FF_4FF6_97DE_5A99E7D5705A */
@@ -0,0 +1,60 @@
+#ifndef E2B4FDA0_D0C5_4ACE_8439_C8AC7DFFE9F9
+#define E2B4FDA0_D0C5_4ACE_8439_C8AC7DFFE9F9
+
+#include <glm/ext/quaternion_float.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+namespace ige::plugin::transform {
+
+/**
+ * @brief Affine transformation, stored as the first three rows of a 4x4
+ * matrix (the last row always being `(0, 0, 0, 1)`).
+ *
+ * Rows map well to SIMD registers: transforming a point is three dot
+ * products, and multiplying two affine transformations only takes 12
+ * multiply-adds per row.
+ */
+struct Affine {
+    glm::vec4 rows[3] = {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+    };
+
+    /**
+     * @brief Convert a 4x4 matrix whose last row is `(0, 0, 0, 1)`.
+     */
+    static Affine from_mat4(const glm::mat4&);
+
+    /**
+     * @brief Compute `translate(t) * mat4_cast(r) * scale(s)`.
+     */
+    static Affine from_trs(glm::vec3 t, glm::quat r, glm::vec3 s);
+
+    /**
+     * @brief Batched version of `from_trs`.
+     *
+     * All spans must have the same size. Elements are processed several at a
+     * time using SIMD instructions when available.
+     */
+    static void from_trs(
+        std::span<const glm::vec3> translations,
+        std::span<const glm::quat> rotations, std::span<const glm::vec3> scales,
+        std::span<Affine> out);
+
+    Affine operator*(const Affine&) const;
+
+    /**
+     * @brief Invert any (invertible) affine transformation.
+     */
+    Affine inverse() const;
+
+    glm::mat4 to_mat4() const;
+};
+
+}
+
+#endif /* E2B4FDA0_D0C5_4ACE_8439_C8AC7DFFE9F9 */
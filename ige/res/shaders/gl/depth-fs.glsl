@@ -0,0 +1,6 @@
+#version 410 core
+
+// depth pre-pass: depth is written by the fixed function pipeline
+void main()
+{
+}
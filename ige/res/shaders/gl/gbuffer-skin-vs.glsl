@@ -1,11 +1,25 @@
 #version 410 core
 
-const int MAX_JOINTS = 64;
 const int MAX_WEIGHTS = 4;
 
-uniform mat4 u_ProjViewModel;
-uniform mat3 u_NormalMatrix;
-uniform mat4 u_JointMatrix[MAX_JOINTS];
+layout(std140) uniform Frame
+{
+    mat4 u_Projection;
+    mat4 u_View;
+    mat4 u_InvProjection;
+};
+
+layout(std140) uniform Draw
+{
+    mat4 u_ViewModel;
+    mat3 u_NormalMatrix;
+
+    // first matrix of the skeleton's palette in u_Joints
+    int u_JointOffset;
+};
+
+// joint palettes of every skeleton, four texels (columns) per matrix
+uniform samplerBuffer u_Joints;
 
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
@@ -16,13 +30,25 @@ layout(location = 4) in vec4 a_Weights;
 out vec3 v_Normal;
 out vec2 v_TexCoords;
 
+// the depth pre-pass and the gbuffer pass must compute the same depths
+invariant gl_Position;
+
+mat4 joint_matrix(int joint)
+{
+    int texel = (u_JointOffset + joint) * 4;
+
+    return mat4(
+        texelFetch(u_Joints, texel), texelFetch(u_Joints, texel + 1),
+        texelFetch(u_Joints, texel + 2), texelFetch(u_Joints, texel + 3));
+}
+
 void main()
 {
     mat4 skin_matrix
-        = (a_Weights.x * u_JointMatrix[a_Joints.x]
-           + a_Weights.y * u_JointMatrix[a_Joints.y]
-           + a_Weights.z * u_JointMatrix[a_Joints.z]
-           + a_Weights.w * u_JointMatrix[a_Joints.w]);
+        = (a_Weights.x * joint_matrix(a_Joints.x)
+           + a_Weights.y * joint_matrix(a_Joints.y)
+           + a_Weights.z * joint_matrix(a_Joints.z)
+           + a_Weights.w * joint_matrix(a_Joints.w));
 
     vec4 skinned_pos = skin_matrix * vec4(a_Position, 1.0);
     vec3 skinned_normal = mat3(skin_matrix) * a_Normal;
@@ -30,5 +56,5 @@ void main()
     v_Normal = u_NormalMatrix * skinned_normal;
     v_TexCoords = a_TexCoords;
 
-    gl_Position = u_ProjViewModel * skinned_pos;
+    gl_Position = u_Projection * u_ViewModel * skinned_pos;
 }
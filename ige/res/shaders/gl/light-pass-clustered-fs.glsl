@@ -0,0 +1,130 @@
+#version 410 core
+
+#define LIGHT_TYPE_AMBIENT 0
+#define LIGHT_TYPE_POINT 1
+#define LIGHT_TYPE_DIRECTIONAL 2
+
+// see LightClusters
+#define TILES_X 16
+#define TILES_Y 9
+#define SLICES 24
+
+uniform sampler2D u_GbufferAlbedo;
+uniform sampler2D u_GbufferNormal;
+uniform sampler2D u_GbufferDepth;
+
+// two texels per light: (position or direction, range) and (diffuse, type)
+uniform samplerBuffer u_Lights;
+
+// (offset, count) of the lights of each cluster in u_LightIndices
+uniform usamplerBuffer u_Clusters;
+uniform usamplerBuffer u_LightIndices;
+
+// ambient and directional lights come first in u_Lights, they shade every
+// pixel and aren't part of any cluster
+uniform int u_GlobalLightCount;
+
+// near plane and scale of the depth slices
+uniform vec2 u_ClusterSlices;
+
+layout(std140) uniform Frame
+{
+    mat4 u_Projection;
+    mat4 u_View;
+    mat4 u_InvProjection;
+};
+
+in vec2 v_TexCoords;
+
+out vec4 o_Color;
+
+vec3 unproject(vec3 screen)
+{
+    vec4 view = u_InvProjection * vec4(screen.xyz, 1.0);
+
+    return view.xyz / view.w;
+}
+
+vec3 decode_normal(vec2 enc)
+{
+    vec2 fenc = enc * 4.0 - 2.0;
+    float f = dot(fenc, fenc);
+    float g = sqrt(1.0 - f / 4.0);
+
+    return vec3(fenc * g, 1.0 - f / 2.0);
+}
+
+// see light-pass-fs.glsl
+float incidence_factor(vec3 normal, vec3 dir)
+{
+    return max(dot(normal, dir), 0.0);
+}
+
+float do_point_light(vec3 normal, vec3 light_pos, vec3 frag_pos, float range)
+{
+    vec3 light_vector = light_pos - frag_pos;
+    float light_distance = length(light_vector);
+
+    float falloff = 1.0 - pow(clamp(light_distance / range, 0.0, 1.0), 2);
+
+    return falloff * incidence_factor(normal, normalize(light_vector));
+}
+
+vec3 shade(int light, vec3 normal, vec3 view_pos)
+{
+    vec4 position = texelFetch(u_Lights, light * 2);
+    vec4 diffuse = texelFetch(u_Lights, light * 2 + 1);
+    float amount = 1.0;
+
+    switch (int(diffuse.w)) {
+    case LIGHT_TYPE_POINT:
+        amount = do_point_light(normal, position.xyz, view_pos, position.w);
+        break;
+    case LIGHT_TYPE_DIRECTIONAL:
+        amount = incidence_factor(normal, -position.xyz);
+        break;
+    }
+
+    return diffuse.rgb * amount;
+}
+
+int cluster_index(vec3 view_pos)
+{
+    ivec2 tile = min(
+        ivec2(v_TexCoords * vec2(TILES_X, TILES_Y)),
+        ivec2(TILES_X - 1, TILES_Y - 1));
+
+    float slice = log(-view_pos.z / u_ClusterSlices.x) * u_ClusterSlices.y;
+    int z = clamp(int(slice), 0, SLICES - 1);
+
+    return (z * TILES_Y + tile.y) * TILES_X + tile.x;
+}
+
+void main()
+{
+    vec4 albedo = texture(u_GbufferAlbedo, v_TexCoords);
+
+    if (albedo.a == 0.0) {
+        discard;
+    }
+
+    vec3 normal = decode_normal(texture(u_GbufferNormal, v_TexCoords).xy);
+    float depth = texture(u_GbufferDepth, v_TexCoords).r;
+    vec3 view_pos = unproject(vec3(v_TexCoords, depth) * 2.0 - 1.0);
+
+    vec3 light = vec3(0.0);
+
+    for (int i = 0; i < u_GlobalLightCount; i++) {
+        light += shade(i, normal, view_pos);
+    }
+
+    uvec2 cluster = texelFetch(u_Clusters, cluster_index(view_pos)).xy;
+
+    for (uint i = 0u; i < cluster.y; i++) {
+        int index = int(texelFetch(u_LightIndices, int(cluster.x + i)).r);
+
+        light += shade(u_GlobalLightCount + index, normal, view_pos);
+    }
+
+    o_Color = vec4(albedo.rgb * light, albedo.a);
+}
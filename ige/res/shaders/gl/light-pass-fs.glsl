@@ -7,11 +7,17 @@
 uniform sampler2D u_GbufferAlbedo;
 uniform sampler2D u_GbufferNormal;
 uniform sampler2D u_GbufferDepth;
-uniform mat4 u_InvProjection;
 uniform int u_LightType;
 uniform vec4 u_LightPosition;
 uniform vec3 u_LightDiffuse;
 
+layout(std140) uniform Frame
+{
+    mat4 u_Projection;
+    mat4 u_View;
+    mat4 u_InvProjection;
+};
+
 in vec2 v_TexCoords;
 
 out vec4 o_Color;
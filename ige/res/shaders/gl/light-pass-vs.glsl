@@ -1,11 +1,16 @@
 #version 410 core
 
+// part of the screen to cover (min x, min y, max x, max y), in NDC
+uniform vec4 u_LightRect;
+
 layout(location = 0) in vec2 a_Position;
 
 out vec2 v_TexCoords;
 
 void main()
 {
-    v_TexCoords = a_Position;
-    gl_Position = vec4(a_Position * 2.0 - 1.0, 0.0, 1.0);
+    vec2 position = mix(u_LightRect.xy, u_LightRect.zw, a_Position);
+
+    v_TexCoords = position * 0.5 + 0.5;
+    gl_Position = vec4(position, 0.0, 1.0);
 }
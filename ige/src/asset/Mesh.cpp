@@ -1,10 +1,66 @@
 #include "igepch.hpp"
 
 #include "ige/asset/Mesh.hpp"
+#include "ige/core/Bounds.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <limits>
 
+using glm::vec3;
 using ige::asset::Mesh;
+using ige::core::Aabb;
+using ige::core::BoundingSphere;
+
+template <typename T>
+static float read_component(const std::byte* data)
+{
+    T value;
+
+    std::memcpy(&value, data, sizeof(T));
+    return static_cast<float>(value);
+}
+
+static std::size_t size_of(Mesh::DataType type)
+{
+    switch (type) {
+    case Mesh::DataType::BYTE:
+    case Mesh::DataType::UNSIGNED_BYTE:
+        return 1;
+    case Mesh::DataType::SHORT:
+    case Mesh::DataType::UNSIGNED_SHORT:
+        return 2;
+    case Mesh::DataType::UNSIGNED_INT:
+    case Mesh::DataType::FLOAT:
+        return 4;
+    default:
+        throw std::runtime_error("Unsupported data type");
+    }
+}
+
+static float read_component(Mesh::DataType type, const std::byte* data)
+{
+    switch (type) {
+    case Mesh::DataType::BYTE:
+        return read_component<std::int8_t>(data);
+    case Mesh::DataType::UNSIGNED_BYTE:
+        return read_component<std::uint8_t>(data);
+    case Mesh::DataType::SHORT:
+        return read_component<std::int16_t>(data);
+    case Mesh::DataType::UNSIGNED_SHORT:
+        return read_component<std::uint16_t>(data);
+    case Mesh::DataType::UNSIGNED_INT:
+        return read_component<std::uint32_t>(data);
+    case Mesh::DataType::FLOAT:
+        return read_component<float>(data);
+    default:
+        throw std::runtime_error("Unsupported data type");
+    }
+}
 
 Mesh Mesh::cube(float s)
 {
@@ -119,6 +175,77 @@ Mesh::Topology Mesh::topology() const
     return m_topology;
 }
 
+const Aabb& Mesh::bounds() const
+{
+    return m_bounds;
+}
+
+const BoundingSphere& Mesh::bounding_sphere() const
+{
+    return m_bounding_sphere;
+}
+
+void Mesh::compute_bounds()
+{
+    const Attribute& attr = m_attr_position;
+    const Buffer& buffer = m_buffers.at(attr.buffer);
+    const std::size_t component_size = size_of(attr.type);
+    const std::size_t element_size = component_size * 3;
+    const std::size_t stride = attr.stride ? attr.stride : element_size;
+
+    // vertices past the last indexed one (if any) aren't part of the mesh
+    std::size_t count = 0;
+
+    if (buffer.size() >= attr.offset + element_size) {
+        count = (buffer.size() - attr.offset - element_size) / stride + 1;
+    }
+
+    if (!m_index_buffer.empty()) {
+        auto last = std::max_element(
+            m_index_buffer.begin(), m_index_buffer.end());
+
+        count = std::min<std::size_t>(count, *last + 1);
+    }
+
+    auto position = [&](std::size_t i) {
+        const std::byte* data = buffer.data() + attr.offset + i * stride;
+
+        return vec3 {
+            read_component(attr.type, data),
+            read_component(attr.type, data + component_size),
+            read_component(attr.type, data + component_size * 2),
+        };
+    };
+
+    if (count == 0) {
+        m_bounds = {};
+        m_bounding_sphere = {};
+        return;
+    }
+
+    vec3 min(std::numeric_limits<float>::max());
+    vec3 max(std::numeric_limits<float>::lowest());
+
+    for (std::size_t i = 0; i < count; i++) {
+        vec3 p = position(i);
+
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    m_bounds = { min, max };
+
+    // centered on the box: not the tightest sphere, but close enough
+    vec3 center = m_bounds.center();
+    float radius = 0.0f;
+
+    for (std::size_t i = 0; i < count; i++) {
+        radius = std::max(radius, glm::distance(center, position(i)));
+    }
+
+    m_bounding_sphere = { center, radius };
+}
+
 /* Mesh Builder */
 Mesh Mesh::Builder::build()
 {
@@ -152,6 +279,7 @@ Mesh Mesh::Builder::build()
     mesh.m_attr_weights = m_attr_weights;
     m_attr_weights.reset();
 
+    mesh.compute_bounds();
     return mesh;
 }
 
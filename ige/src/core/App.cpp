@@ -6,13 +6,28 @@
 #include "ige/ecs/Schedule.hpp"
 #include "ige/ecs/System.hpp"
 #include "ige/ecs/World.hpp"
+#include <exception>
+#include <functional>
+#include <semaphore>
+#include <thread>
 
 using ige::core::App;
+using ige::core::MainWorld;
 using ige::core::StateMachine;
 using ige::ecs::Resources;
 using ige::ecs::Schedule;
 using ige::ecs::World;
 
+MainWorld::MainWorld(World& world)
+    : m_world(&world)
+{
+}
+
+World& MainWorld::get() const
+{
+    return *m_world;
+}
+
 App::App(
     Resources res, Schedule on_start, Schedule on_update, Schedule on_cleanup)
     : m_world(std::move(res))
@@ -64,6 +79,82 @@ App::Builder::add_cleanup_system(std::unique_ptr<ecs::System> system) &&
     return std::move(add_cleanup_system(std::move(system)));
 }
 
+App::Builder&
+App::Builder::add_extract_system(std::unique_ptr<ecs::System> system) &
+{
+    m_extract.add_system(std::move(system));
+    return *this;
+}
+
+App::Builder
+App::Builder::add_extract_system(std::unique_ptr<ecs::System> system) &&
+{
+    return std::move(add_extract_system(std::move(system)));
+}
+
+App::Builder&
+App::Builder::add_begin_frame_system(std::unique_ptr<ecs::System> system) &
+{
+    m_begin_frame.add_system(std::move(system));
+    return *this;
+}
+
+App::Builder
+App::Builder::add_begin_frame_system(std::unique_ptr<ecs::System> system) &&
+{
+    return std::move(add_begin_frame_system(std::move(system)));
+}
+
+App::Builder&
+App::Builder::add_render_system(std::unique_ptr<ecs::System> system) &
+{
+    m_render.add_system(std::move(system));
+    return *this;
+}
+
+App::Builder
+App::Builder::add_render_system(std::unique_ptr<ecs::System> system) &&
+{
+    return std::move(add_render_system(std::move(system)));
+}
+
+App::Builder&
+App::Builder::add_present_system(std::unique_ptr<ecs::System> system) &
+{
+    m_present.add_system(std::move(system));
+    return *this;
+}
+
+App::Builder
+App::Builder::add_present_system(std::unique_ptr<ecs::System> system) &&
+{
+    return std::move(add_present_system(std::move(system)));
+}
+
+App::Builder&
+App::Builder::add_render_cleanup_system(std::unique_ptr<ecs::System> system) &
+{
+    m_render_cleanup.add_system(std::move(system));
+    return *this;
+}
+
+App::Builder
+App::Builder::add_render_cleanup_system(std::unique_ptr<ecs::System> system) &&
+{
+    return std::move(add_render_cleanup_system(std::move(system)));
+}
+
+App::Builder& App::Builder::set_pipelined(bool pipelined) &
+{
+    m_pipelined = pipelined;
+    return *this;
+}
+
+App::Builder App::Builder::set_pipelined(bool pipelined) &&
+{
+    return std::move(set_pipelined(pipelined));
+}
+
 App::Builder& App::Builder::add_plugin(const App::Plugin& plugin)
 {
     plugin.plug(*this);
@@ -80,6 +171,16 @@ const World& App::world() const
     return m_world;
 }
 
+World& App::render_world()
+{
+    return m_render_world;
+}
+
+const World& App::render_world() const
+{
+    return m_render_world;
+}
+
 StateMachine& App::state_machine()
 {
     return m_state_machine;
@@ -90,14 +191,115 @@ const StateMachine& App::state_machine() const
     return m_state_machine;
 }
 
-void App::run()
+// runs the render schedules of an app on its own thread, one frame at a time
+class RenderThread {
+public:
+    RenderThread(std::function<void()> render, Schedule& cleanup, World& world)
+        : m_thread([this, render = std::move(render), &cleanup, &world] {
+            try {
+                for (;;) {
+                    m_frame_ready.acquire();
+
+                    if (!m_running) {
+                        break;
+                    }
+
+                    render();
+                    m_frame_done.release();
+                }
+
+                cleanup.run_reverse(world);
+            } catch (...) {
+                m_error = std::current_exception();
+                m_frame_done.release();
+            }
+        })
+    {
+    }
+
+    ~RenderThread()
+    {
+        if (!m_idle) {
+            m_frame_done.acquire();
+        }
+
+        m_running = false;
+        m_frame_ready.release();
+        m_thread.join();
+    }
+
+    // wait for the frame being rendered (if any) to be done
+    void wait()
+    {
+        m_frame_done.acquire();
+        m_idle = true;
+
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    // start rendering the last extracted frame
+    void kick()
+    {
+        m_idle = false;
+        m_frame_ready.release();
+    }
+
+private:
+    std::binary_semaphore m_frame_ready { 0 };
+    std::binary_semaphore m_frame_done { 1 };
+    bool m_idle = false;
+    bool m_running = true;
+    std::exception_ptr m_error;
+    std::thread m_thread;
+};
+
+void App::extract()
 {
-    m_startup.run_forward(m_world);
+    m_extract.run_forward(m_render_world);
+}
+
+void App::render()
+{
+    m_begin_frame.run_forward(m_render_world);
+    m_render.run_forward(m_render_world);
+    m_present.run_forward(m_render_world);
+}
+
+void App::run_pipelined()
+{
+    RenderThread renderer(
+        [this] { render(); }, m_render_cleanup, m_render_world);
 
     do {
         m_state_machine.update(*this);
         m_update.run_forward(m_world);
+
+        // the render world can only be written once the previous frame is done
+        renderer.wait();
+        extract();
+        renderer.kick();
     } while (m_state_machine.is_running());
+}
+
+void App::run()
+{
+    m_render_world.insert(MainWorld { m_world });
+    m_startup.run_forward(m_world);
+
+    if (m_pipelined) {
+        run_pipelined();
+    } else {
+        do {
+            m_state_machine.update(*this);
+            m_update.run_forward(m_world);
+            extract();
+            render();
+        } while (m_state_machine.is_running());
+
+        m_render_cleanup.run_reverse(m_render_world);
+    }
 
     m_cleanup.run_reverse(m_world);
 }
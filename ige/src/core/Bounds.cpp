@@ -0,0 +1,318 @@
+#include "igepch.hpp"
+
+#include "ige/core/Bounds.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+#if defined(__SSE__) || defined(_M_X64)                                        \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define IGE_BOUNDS_SSE
+#include <xmmintrin.h>
+#endif
+
+using glm::mat4;
+using glm::vec2;
+using glm::vec3;
+using glm::vec4;
+using ige::core::Aabb;
+using ige::core::BoundingSphere;
+using ige::core::Frustum;
+using ige::core::Ray;
+
+vec3 Aabb::center() const
+{
+    return (min + max) * 0.5f;
+}
+
+vec3 Aabb::extents() const
+{
+    return (max - min) * 0.5f;
+}
+
+Aabb Aabb::transformed(const mat4& m) const
+{
+    vec3 c = vec3(m * vec4(center(), 1.0f));
+    vec3 e = extents();
+
+    // each axis of the box adds the absolute value of its image to the extents
+    vec3 world_extents = glm::abs(vec3(m[0])) * e.x
+        + glm::abs(vec3(m[1])) * e.y + glm::abs(vec3(m[2])) * e.z;
+
+    return { c - world_extents, c + world_extents };
+}
+
+Aabb Aabb::merged(const Aabb& other) const
+{
+    return { glm::min(min, other.min), glm::max(max, other.max) };
+}
+
+Aabb Aabb::inflated(vec3 margin) const
+{
+    return { min - margin, max + margin };
+}
+
+float Aabb::surface_area() const
+{
+    vec3 size = max - min;
+
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool Aabb::contains(const Aabb& other) const
+{
+    return min.x <= other.min.x && min.y <= other.min.y
+        && min.z <= other.min.z && other.max.x <= max.x
+        && other.max.y <= max.y && other.max.z <= max.z;
+}
+
+bool Aabb::intersects(const Aabb& other) const
+{
+    return min.x <= other.max.x && other.min.x <= max.x
+        && min.y <= other.max.y && other.min.y <= max.y
+        && min.z <= other.max.z && other.min.z <= max.z;
+}
+
+bool Aabb::intersects(const BoundingSphere& sphere) const
+{
+    vec3 closest = glm::clamp(sphere.center, min, max);
+    vec3 offset = closest - sphere.center;
+
+    return glm::dot(offset, offset) <= sphere.radius * sphere.radius;
+}
+
+bool Aabb::intersects(const Ray& ray, float max_distance) const
+{
+    float near = 0.0f;
+    float far = max_distance;
+
+    // slab test: intersect the ray with each pair of parallel planes
+    for (int axis = 0; axis < 3; axis++) {
+        float origin = ray.origin[axis];
+        float direction = ray.direction[axis];
+
+        if (direction == 0.0f) {
+            if (origin < min[axis] || origin > max[axis]) {
+                return false;
+            }
+
+            continue;
+        }
+
+        float inv = 1.0f / direction;
+        float t0 = (min[axis] - origin) * inv;
+        float t1 = (max[axis] - origin) * inv;
+
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+
+        near = glm::max(near, t0);
+        far = glm::min(far, t1);
+
+        if (near > far) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+BoundingSphere BoundingSphere::transformed(const mat4& m) const
+{
+    float scale = glm::max(
+        glm::length(vec3(m[0])),
+        glm::max(glm::length(vec3(m[1])), glm::length(vec3(m[2]))));
+
+    return { vec3(m * vec4(center, 1.0f)), radius * scale };
+}
+
+vec4 BoundingSphere::screen_rect(const mat4& projection) const
+{
+    const vec4 screen(-1.0f, -1.0f, 1.0f, 1.0f);
+
+    // the projection of the box around the sphere contains the projection of
+    // the sphere, as long as the box is entirely in front of the camera
+    vec2 min(1.0f);
+    vec2 max(-1.0f);
+
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = center;
+        corner.x += i & 1 ? radius : -radius;
+        corner.y += i & 2 ? radius : -radius;
+        corner.z += i & 4 ? radius : -radius;
+
+        vec4 clip = projection * vec4(corner, 1.0f);
+
+        if (clip.w <= 1e-5f) {
+            return screen;
+        }
+
+        vec2 ndc = vec2(clip) / clip.w;
+
+        min = glm::min(min, ndc);
+        max = glm::max(max, ndc);
+    }
+
+    return glm::clamp(vec4(min, max), vec4(-1.0f), vec4(1.0f));
+}
+
+Frustum Frustum::from_matrix(const mat4& m)
+{
+    Frustum frustum;
+
+    // rows of the matrix (glm matrices are column-major)
+    vec4 rows[4];
+
+    for (int i = 0; i < 4; i++) {
+        rows[i] = vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    }
+
+    // -w <= x, y, z <= w
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = rows[3] + rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+
+    for (vec4& plane : frustum.planes) {
+        plane /= glm::length(vec3(plane));
+    }
+
+    return frustum;
+}
+
+bool Frustum::intersects(const Aabb& box) const
+{
+    for (const vec4& plane : planes) {
+        vec3 normal(plane);
+
+        // corner of the box the furthest along the normal
+        vec3 corner {
+            normal.x >= 0.0f ? box.max.x : box.min.x,
+            normal.y >= 0.0f ? box.max.y : box.min.y,
+            normal.z >= 0.0f ? box.max.z : box.min.z,
+        };
+
+        if (glm::dot(normal, corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const
+{
+    for (const vec4& plane : planes) {
+        if (glm::dot(vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t Frustum::cull(
+    std::span<const Aabb> boxes, std::span<std::uint8_t> visible) const
+{
+    std::size_t count = 0;
+    std::size_t i = 0;
+
+#ifdef IGE_BOUNDS_SSE
+    // the loads below read the 6 floats of a box as two overlapping vec4s
+    static_assert(sizeof(Aabb) == 6 * sizeof(float));
+
+    __m128 normals[6][3];
+    __m128 distances[6];
+
+    for (int p = 0; p < 6; p++) {
+        normals[p][0] = _mm_set1_ps(planes[p].x);
+        normals[p][1] = _mm_set1_ps(planes[p].y);
+        normals[p][2] = _mm_set1_ps(planes[p].z);
+        distances[p] = _mm_set1_ps(planes[p].w);
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= boxes.size(); i += 4) {
+        const float* b = &boxes[i].min.x;
+
+        // (min.x, min.y, min.z, max.x) of each box, transposed
+        __m128 min_x = _mm_loadu_ps(b);
+        __m128 min_y = _mm_loadu_ps(b + 6);
+        __m128 min_z = _mm_loadu_ps(b + 12);
+        __m128 max_x = _mm_loadu_ps(b + 18);
+        _MM_TRANSPOSE4_PS(min_x, min_y, min_z, max_x);
+
+        // (min.z, max.x, max.y, max.z) of each box, transposed
+        __m128 again_min_z = _mm_loadu_ps(b + 2);
+        __m128 again_max_x = _mm_loadu_ps(b + 8);
+        __m128 max_y = _mm_loadu_ps(b + 14);
+        __m128 max_z = _mm_loadu_ps(b + 20);
+        _MM_TRANSPOSE4_PS(again_min_z, again_max_x, max_y, max_z);
+
+        __m128 outside = zero;
+
+        for (int p = 0; p < 6; p++) {
+            // corners of the boxes the furthest along the normal
+            const __m128 x = planes[p].x >= 0.0f ? max_x : min_x;
+            const __m128 y = planes[p].y >= 0.0f ? max_y : min_y;
+            const __m128 z = planes[p].z >= 0.0f ? max_z : min_z;
+
+            __m128 d = _mm_add_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(normals[p][0], x), _mm_mul_ps(normals[p][1], y)),
+                _mm_mul_ps(normals[p][2], z));
+            d = _mm_add_ps(d, distances[p]);
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, zero));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+
+        for (std::size_t j = 0; j < 4; j++) {
+            bool inside = (mask & (1 << j)) == 0;
+
+            visible[i + j] = inside;
+            count += inside;
+        }
+    }
+#endif
+
+    for (; i < boxes.size(); i++) {
+        bool inside = intersects(boxes[i]);
+
+        visible[i] = inside;
+        count += inside;
+    }
+
+    return count;
+}
+
+bool Frustum::contains(const Aabb& box) const
+{
+    for (const vec4& plane : planes) {
+        vec3 normal(plane);
+
+        // corner of the box the furthest against the normal
+        vec3 corner {
+            normal.x >= 0.0f ? box.min.x : box.max.x,
+            normal.y >= 0.0f ? box.min.y : box.max.y,
+            normal.z >= 0.0f ? box.min.z : box.max.z,
+        };
+
+        if (glm::dot(normal, corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,72 @@
+#include "igepch.hpp"
+
+#include "ige/core/RadixSort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+using ige::core::RadixSort;
+
+void RadixSort::sort(
+    std::span<std::uint64_t> keys, std::span<std::uint32_t> values)
+{
+    const std::size_t size = keys.size();
+
+    if (size < 2) {
+        return;
+    }
+
+    // count every byte of every key in a single pass
+    std::array<std::array<std::size_t, 256>, 8> counts {};
+
+    for (std::uint64_t key : keys) {
+        for (std::size_t byte = 0; byte < 8; byte++) {
+            counts[byte][(key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+
+    m_keys.resize(size);
+    m_values.resize(size);
+
+    std::span<std::uint64_t> src_keys = keys;
+    std::span<std::uint32_t> src_values = values;
+    std::span<std::uint64_t> dst_keys = m_keys;
+    std::span<std::uint32_t> dst_values = m_values;
+
+    for (std::size_t byte = 0; byte < 8; byte++) {
+        auto& count = counts[byte];
+        const std::size_t shift = byte * 8;
+
+        // all keys have the same byte, nothing would move
+        if (count[(src_keys[0] >> shift) & 0xFF] == size) {
+            continue;
+        }
+
+        std::array<std::size_t, 256> offsets;
+        std::size_t offset = 0;
+
+        for (std::size_t digit = 0; digit < 256; digit++) {
+            offsets[digit] = offset;
+            offset += count[digit];
+        }
+
+        for (std::size_t i = 0; i < size; i++) {
+            std::size_t& dst = offsets[(src_keys[i] >> shift) & 0xFF];
+
+            dst_keys[dst] = src_keys[i];
+            dst_values[dst] = src_values[i];
+            dst++;
+        }
+
+        std::swap(src_keys, dst_keys);
+        std::swap(src_values, dst_values);
+    }
+
+    // an odd number of passes left the result in the scratch buffers
+    if (src_keys.data() != keys.data()) {
+        std::copy(src_keys.begin(), src_keys.end(), keys.begin());
+        std::copy(src_values.begin(), src_values.end(), values.begin());
+    }
+}
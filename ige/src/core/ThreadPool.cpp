@@ -0,0 +1,147 @@
+#include "igepch.hpp"
+
+#include "ige/core/ThreadPool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using ige::core::ThreadPool;
+
+struct ThreadPool::Shared {
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::vector<std::thread> workers;
+
+    // current loop, bumped each time `for_each` starts a new one
+    std::uint64_t generation = 0;
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t count = 0;
+    std::atomic<std::size_t> next = 0;
+
+    // workers that haven't finished the current loop yet
+    std::size_t busy = 0;
+    std::exception_ptr error;
+    bool stopping = false;
+
+    void run_jobs()
+    {
+        std::size_t i;
+
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+            try {
+                (*job)(i);
+            } catch (...) {
+                std::lock_guard lock(mutex);
+
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void work()
+    {
+        std::uint64_t seen = 0;
+        std::unique_lock lock(mutex);
+
+        while (true) {
+            work_ready.wait(
+                lock, [&] { return stopping || generation != seen; });
+
+            if (stopping) {
+                return;
+            }
+
+            seen = generation;
+
+            lock.unlock();
+            run_jobs();
+            lock.lock();
+
+            if (--busy == 0) {
+                work_done.notify_one();
+            }
+        }
+    }
+};
+
+ThreadPool::ThreadPool()
+    : ThreadPool(std::thread::hardware_concurrency())
+{
+}
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : m_shared(std::make_unique<Shared>())
+{
+    for (std::size_t i = 1; i < threads; i++) {
+        m_shared->workers.emplace_back([shared = m_shared.get()] {
+            shared->work();
+        });
+    }
+}
+
+ThreadPool::ThreadPool(ThreadPool&&) = default;
+ThreadPool& ThreadPool::operator=(ThreadPool&&) = default;
+
+ThreadPool::~ThreadPool()
+{
+    if (!m_shared) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_shared->mutex);
+        m_shared->stopping = true;
+    }
+
+    m_shared->work_ready.notify_all();
+
+    for (auto& worker : m_shared->workers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const
+{
+    return m_shared->workers.size() + 1;
+}
+
+void ThreadPool::for_each(
+    std::size_t count, const std::function<void(std::size_t)>& job)
+{
+    Shared& shared = *m_shared;
+
+    // not worth waking anyone up
+    if (shared.workers.empty() || count <= 1) {
+        for (std::size_t i = 0; i < count; i++) {
+            job(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard lock(shared.mutex);
+
+        shared.generation++;
+        shared.job = &job;
+        shared.count = count;
+        shared.next = 0;
+        shared.busy = shared.workers.size();
+        shared.error = nullptr;
+    }
+
+    shared.work_ready.notify_all();
+    shared.run_jobs();
+
+    std::unique_lock lock(shared.mutex);
+    shared.work_done.wait(lock, [&] { return shared.busy == 0; });
+
+    if (shared.error) {
+        std::rethrow_exception(std::exchange(shared.error, nullptr));
+    }
+}
@@ -17,6 +17,15 @@ bool World::exists(const EntityId& ent)
     return m_entities.exists(ent);
 }
 
+std::optional<EntityId> World::entity_at(std::size_t index) const
+{
+    if (auto generation = m_generation.get(index)) {
+        return EntityId { index, *generation };
+    } else {
+        return std::nullopt;
+    }
+}
+
 bool World::remove_entity(const EntityId& ent)
 {
     if (m_entities.release(ent)) {
@@ -0,0 +1,68 @@
+#include "igepch.hpp"
+
+#include "ige/core/App.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/System.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/SpatialIndexPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "transform/TransformHierarchy.hpp"
+
+using ige::core::App;
+using ige::ecs::EntityId;
+using ige::ecs::System;
+using ige::ecs::World;
+using ige::plugin::spatial::SpatialIndex;
+using ige::plugin::spatial::SpatialIndexPlugin;
+using ige::plugin::transform::WorldBounds;
+
+// what the index was last synchronized with
+struct IndexedBounds {
+    std::optional<std::uint64_t> version;
+    std::vector<EntityId> entities;
+};
+
+static void update_spatial_index(World& world)
+{
+    auto& index = world.get_or_emplace<SpatialIndex>();
+    auto& indexed = world.get_or_emplace<IndexedBounds>();
+    auto bounds = world.get_component_storage<WorldBounds>();
+    std::optional<std::uint64_t> version;
+
+    if (bounds) {
+        version = bounds->version();
+    }
+
+    if (version != indexed.version) {
+        // bounds were added or removed: go through all of them
+        for (auto entity : indexed.entities) {
+            if (world.entity_at(entity.index()) != entity
+                || !world.get_component<WorldBounds>(entity)) {
+                index.remove(entity);
+            }
+        }
+
+        indexed.version = version;
+        indexed.entities.clear();
+
+        for (auto [entity, entity_bounds] : world.query<WorldBounds>()) {
+            index.update(entity, entity_bounds.aabb());
+            indexed.entities.push_back(entity);
+        }
+    } else if (auto hierarchy = world.get<TransformHierarchy>()) {
+        for (auto entity : hierarchy->updated_bounds()) {
+            if (auto entity_bounds = world.get_component<WorldBounds>(entity)) {
+                index.update(entity, entity_bounds->aabb());
+            }
+        }
+    }
+
+    if (!index.balanced()) {
+        index.rebalance();
+    }
+}
+
+void SpatialIndexPlugin::plug(App::Builder& builder) const
+{
+    builder.add_system(System::from(update_spatial_index));
+}
@@ -86,105 +86,108 @@ static void trigger_events(World& world)
 
     vec2 mouse_pos = input_mgr->mouse().get_position();
 
-    while (auto event = events->sub.next_event()) {
-        if (event->type != InputEventType::MOUSE) {
-            // next event!
-            continue;
-        }
-
-        for (auto [ent, target, rect] : entities) {
-            vec2 min = rect.abs_bounds_min();
-            vec2 max = rect.abs_bounds_max();
+    for (auto batch : events->sub.drain()) {
+        for (const InputEvent& event : batch) {
+            if (event.type != InputEventType::MOUSE) {
+                // next event!
+                continue;
+            }
 
-            // input event have the origin in the top left corner
-            min.y = static_cast<float>(wininfo->height) - min.y;
-            max.y = static_cast<float>(wininfo->height) - max.y;
-            std::swap(min.y, max.y);
+            for (auto [ent, target, rect] : entities) {
+                vec2 min = rect.abs_bounds_min();
+                vec2 max = rect.abs_bounds_max();
 
-            bool is_inside = mouse_pos.x >= min.x && mouse_pos.y >= min.y
-                && mouse_pos.x <= max.x && mouse_pos.y <= max.y;
+                // input event have the origin in the top left corner
+                min.y = static_cast<float>(wininfo->height) - min.y;
+                max.y = static_cast<float>(wininfo->height) - max.y;
+                std::swap(min.y, max.y);
 
-            // make sure the cursor is in the rectangle
-            if (!is_inside) {
-                if (world.get_component<MouseMovement>(ent)) {
-                    using ige::plugin::ui::event::MouseLeave;
+                bool is_inside = mouse_pos.x >= min.x && mouse_pos.y >= min.y
+                    && mouse_pos.x <= max.x && mouse_pos.y <= max.y;
 
-                    MouseLeave evt;
-                    evt.absolute_pos = mouse_pos;
-                    evt.pos = mouse_pos - min;
-                    target.trigger<MouseLeave>(world, ent, evt);
+                // make sure the cursor is in the rectangle
+                if (!is_inside) {
+                    if (world.get_component<MouseMovement>(ent)) {
+                        using ige::plugin::ui::event::MouseLeave;
 
-                    world.remove_component<MouseMovement>(ent);
-                }
+                        MouseLeave evt;
+                        evt.absolute_pos = mouse_pos;
+                        evt.pos = mouse_pos - min;
+                        target.trigger<MouseLeave>(world, ent, evt);
 
-                // next entity!
-                continue;
-            }
+                        world.remove_component<MouseMovement>(ent);
+                    }
 
-            auto& movement
-                = world.get_or_emplace_component<MouseMovement>(ent, mouse_pos);
-
-            using ige::plugin::ui::event::MouseClick;
-            using ige::plugin::ui::event::MouseDown;
-            using ige::plugin::ui::event::MouseEnter;
-            using ige::plugin::ui::event::MouseMove;
-            using ige::plugin::ui::event::MouseScroll;
-            using ige::plugin::ui::event::MouseUp;
-
-            switch (event->mouse.type) {
-            case MouseEventType::BUTTON: {
-                if (event->mouse.button.state == InputRegistryState::PRESSED) {
-                    MouseDown evt;
-                    evt.button = event->mouse.button.button;
-                    evt.absolute_pos = mouse_pos;
-                    evt.pos = mouse_pos - min;
+                    // next entity!
+                    continue;
+                }
 
-                    target.trigger<MouseDown>(world, ent, evt);
+                auto& movement = world.get_or_emplace_component<MouseMovement>(
+                    ent, mouse_pos);
+
+                using ige::plugin::ui::event::MouseClick;
+                using ige::plugin::ui::event::MouseDown;
+                using ige::plugin::ui::event::MouseEnter;
+                using ige::plugin::ui::event::MouseMove;
+                using ige::plugin::ui::event::MouseScroll;
+                using ige::plugin::ui::event::MouseUp;
+
+                switch (event.mouse.type) {
+                case MouseEventType::BUTTON: {
+                    if (event.mouse.button.state
+                        == InputRegistryState::PRESSED) {
+                        MouseDown evt;
+                        evt.button = event.mouse.button.button;
+                        evt.absolute_pos = mouse_pos;
+                        evt.pos = mouse_pos - min;
+
+                        target.trigger<MouseDown>(world, ent, evt);
+
+                        movement.down = true;
+                    } else {
+                        MouseUp evt;
+                        evt.button = event.mouse.button.button;
+                        evt.absolute_pos = mouse_pos;
+                        evt.pos = mouse_pos - min;
+
+                        target.trigger<MouseUp>(world, ent, evt);
+
+                        if (movement.down) {
+                            MouseClick click_evt;
+                            click_evt.button = evt.button;
+                            click_evt.absolute_pos = evt.absolute_pos;
+                            click_evt.pos = evt.pos;
+
+                            target.trigger<MouseClick>(world, ent, click_evt);
+                        }
+                    }
+                } break;
+                case MouseEventType::MOUSE_MOVE: {
+                    if (!movement.entered) {
+                        MouseEnter evt;
+                        evt.absolute_pos = mouse_pos;
+                        evt.pos = mouse_pos - min;
+
+                        target.trigger<MouseEnter>(world, ent, evt);
+                        movement.entered = true;
+                    }
 
-                    movement.down = true;
-                } else {
-                    MouseUp evt;
-                    evt.button = event->mouse.button.button;
+                    MouseMove evt;
                     evt.absolute_pos = mouse_pos;
                     evt.pos = mouse_pos - min;
 
-                    target.trigger<MouseUp>(world, ent, evt);
-
-                    if (movement.down) {
-                        MouseClick click_evt;
-                        click_evt.button = evt.button;
-                        click_evt.absolute_pos = evt.absolute_pos;
-                        click_evt.pos = evt.pos;
-
-                        target.trigger<MouseClick>(world, ent, click_evt);
-                    }
-                }
-            } break;
-            case MouseEventType::MOUSE_MOVE: {
-                if (!movement.entered) {
-                    MouseEnter evt;
+                    target.trigger<MouseMove>(world, ent, evt);
+                } break;
+                case MouseEventType::SCROLL: {
+                    MouseScroll evt;
+                    evt.delta.x = event.mouse.scroll.x;
+                    evt.delta.y = event.mouse.scroll.y;
                     evt.absolute_pos = mouse_pos;
                     evt.pos = mouse_pos - min;
 
-                    target.trigger<MouseEnter>(world, ent, evt);
-                    movement.entered = true;
+                    target.trigger<MouseScroll>(world, ent, evt);
+                } break;
                 }
-
-                MouseMove evt;
-                evt.absolute_pos = mouse_pos;
-                evt.pos = mouse_pos - min;
-
-                target.trigger<MouseMove>(world, ent, evt);
-            } break;
-            case MouseEventType::SCROLL: {
-                MouseScroll evt;
-                evt.delta.x = event->mouse.scroll.x;
-                evt.delta.y = event->mouse.scroll.y;
-                evt.absolute_pos = mouse_pos;
-                evt.pos = mouse_pos - min;
-
-                target.trigger<MouseScroll>(world, ent, evt);
-            } break;
             }
         }
     }
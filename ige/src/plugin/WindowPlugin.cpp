@@ -2,10 +2,14 @@
 
 #include "ige/core/App.hpp"
 #include "ige/core/EventChannel.hpp"
+#include "ige/core/MpscEventChannel.hpp"
 #include "ige/ecs/System.hpp"
 #include "ige/ecs/World.hpp"
 #include "ige/plugin/InputPlugin.hpp"
 #include "ige/plugin/WindowPlugin.hpp"
+#include "plugin/window/EglPbuffer.hpp"
+#include <string>
+#include <utility>
 
 #include <GLFW/glfw3.h>
 
@@ -15,6 +19,9 @@
 
 using ige::core::App;
 using ige::core::EventChannel;
+using ige::core::flush_event_channel;
+using ige::core::MainWorld;
+using ige::core::MpscEventChannel;
 using ige::ecs::System;
 using ige::ecs::World;
 using ige::plugin::input::ControllerAxis;
@@ -28,12 +35,21 @@ using ige::plugin::input::KeyboardKey;
 using ige::plugin::input::MouseButton;
 using ige::plugin::input::MouseEvent;
 using ige::plugin::input::MouseEventType;
+using ige::plugin::window::HeadlessContextError;
+using ige::plugin::window::ReactiveMode;
+using ige::plugin::window::Redraw;
 using ige::plugin::window::WindowEvent;
 using ige::plugin::window::WindowEventKind;
 using ige::plugin::window::WindowInfo;
 using ige::plugin::window::WindowPlugin;
 using ige::plugin::window::WindowSettings;
 
+HeadlessContextError::HeadlessContextError(const std::string& reasons)
+    : std::runtime_error(
+        "Unable to create a headless OpenGL context (" + reasons + ")")
+{
+}
+
 const std::unordered_map<int, InputRegistryState> GLFW_TO_REGISTRY_STATE = {
     { GLFW_PRESS, InputRegistryState::PRESSED },
     { GLFW_RELEASE, InputRegistryState::RELEASED },
@@ -146,7 +162,7 @@ static void key_callback(GLFWwindow* win, int key, int, int action, int)
 {
     World* wld = static_cast<World*>(glfwGetWindowUserPointer(win));
 
-    if (auto events = wld->get<EventChannel<InputEvent>>()) {
+    if (auto events = wld->get<MpscEventChannel<InputEvent>>()) {
         auto k = GLFW_TO_KEYBOARD_KEYS.find(key);
         auto s = GLFW_TO_REGISTRY_STATE.find(action);
 
@@ -164,7 +180,7 @@ static void mouse_button_callback(GLFWwindow* win, int button, int action, int)
 {
     World* wld = static_cast<World*>(glfwGetWindowUserPointer(win));
 
-    if (auto events = wld->get<EventChannel<InputEvent>>()) {
+    if (auto events = wld->get<MpscEventChannel<InputEvent>>()) {
         auto b = GLFW_TO_MOUSE_BUTTON.find(button);
         auto s = GLFW_TO_REGISTRY_STATE.find(action);
 
@@ -183,7 +199,7 @@ static void scroll_callback(GLFWwindow* win, double dx, double dy)
 {
     World* wld = static_cast<World*>(glfwGetWindowUserPointer(win));
 
-    if (auto events = wld->get<EventChannel<InputEvent>>()) {
+    if (auto events = wld->get<MpscEventChannel<InputEvent>>()) {
         InputEvent event;
         event.type = InputEventType::MOUSE;
         event.mouse.type = MouseEventType::SCROLL;
@@ -199,7 +215,7 @@ static void cursor_position_callback(GLFWwindow* win, double xpos, double ypos)
 {
     World* wld = static_cast<World*>(glfwGetWindowUserPointer(win));
 
-    if (auto events = wld->get<EventChannel<InputEvent>>()) {
+    if (auto events = wld->get<MpscEventChannel<InputEvent>>()) {
         InputEvent event;
         event.type = InputEventType::MOUSE;
         event.mouse.type = MouseEventType::MOUSE_MOVE;
@@ -211,8 +227,16 @@ static void cursor_position_callback(GLFWwindow* win, double xpos, double ypos)
     }
 }
 
-static void init_glfw_system(World&)
+static void init_glfw_system(World& wld)
 {
+    auto settings = wld.get<WindowSettings>();
+
+    // the null platform doesn't need a display server (init hints are kept
+    // across initializations, so always set it)
+    bool headless = settings && settings->headless;
+    glfwInitHint(
+        GLFW_PLATFORM, headless ? GLFW_PLATFORM_NULL : GLFW_ANY_PLATFORM);
+
     if (!glfwInit()) {
         throw std::runtime_error("Unable to initialize GLFW");
     }
@@ -225,10 +249,35 @@ static void window_resize_callback(GLFWwindow* win, int width, int height)
     auto& info = wld.get_or_emplace<WindowInfo>();
     info.width = width;
     info.height = height;
+}
+
+// an EGL pbuffer is the default framebuffer of its context, and doesn't need
+// a display server either
+static void create_egl_context(World& wld, const WindowSettings& settings)
+{
+    EglPbuffer pbuffer(settings.width, settings.height);
 
 #ifdef IGE_OPENGL
-    glViewport(0, 0, width, height);
+    pbuffer.make_current();
+
+    int version = gladLoadGLUserPtr(
+        [](void* egl, const char* name) {
+            return static_cast<EglPbuffer*>(egl)->proc_address(name);
+        },
+        &pbuffer);
+
+    if (!version) {
+        throw std::runtime_error("unable to load OpenGL functions");
+    }
+
+    glViewport(0, 0, settings.width, settings.height);
 #endif
+
+    // made current again by the render systems, as for windows
+    pbuffer.release();
+
+    wld.insert(std::move(pbuffer));
+    wld.insert(WindowInfo { settings.width, settings.height });
 }
 
 static void create_window_system(World& wld)
@@ -239,6 +288,22 @@ static void create_window_system(World& wld)
         return;
     }
 
+    std::string egl_error;
+
+    if (settings->headless) {
+        try {
+            create_egl_context(wld, *settings);
+            return;
+        } catch (const std::runtime_error& e) {
+            egl_error = e.what();
+        }
+
+        // fall back to OSMesa (dropped by Mesa 25.1), which renders to a
+        // buffer in memory
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+
 #ifdef IGE_OPENGL
     // Specify which version of OpenGL we want: 4.1 core
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -250,6 +315,16 @@ static void create_window_system(World& wld)
     GLFWwindow* win = glfwCreateWindow(
         settings->width, settings->height, settings->title.c_str(), NULL, NULL);
     if (!win) {
+        if (settings->headless) {
+            const char* osmesa_error = nullptr;
+            glfwGetError(&osmesa_error);
+            glfwTerminate();
+
+            throw HeadlessContextError(
+                "EGL: " + egl_error + ", OSMesa: "
+                + (osmesa_error ? osmesa_error : "unknown error"));
+        }
+
         glfwTerminate();
         throw std::runtime_error("Unable to create GLFW window");
     }
@@ -267,6 +342,10 @@ static void create_window_system(World& wld)
     // Enable V-Sync
     glfwSwapInterval(1);
 
+    // the context is made current again by the render systems, which might
+    // run on another thread
+    glfwMakeContextCurrent(nullptr);
+
     wld.insert(win);
     wld.insert(WindowInfo { settings->width, settings->height });
 
@@ -279,6 +358,8 @@ static void create_window_system(World& wld)
 
 static void destroy_window_system(World& wld)
 {
+    wld.remove<EglPbuffer>();
+
     auto win_opt = wld.remove<GLFWwindow*>();
 
     if (!win_opt) {
@@ -298,20 +379,117 @@ static void update_window_system(World& wld)
 {
     if (auto win = wld.get<GLFWwindow*>()) {
         if (glfwWindowShouldClose(*win)) {
-            if (auto channel = wld.get<EventChannel<WindowEvent>>()) {
+            if (auto channel = wld.get<MpscEventChannel<WindowEvent>>()) {
                 channel->push(WindowEvent {
                     WindowEventKind::WindowClose,
                 });
             }
         }
+    }
+}
+
+static void extract_window_system(World& render_wld)
+{
+    World& wld = render_wld.get<MainWorld>()->get();
+    auto& redraw = render_wld.get_or_emplace<Redraw>();
+
+    // extract systems only ever set it (e.g. when the content of the frame
+    // changed), it is reset once the frame is presented
+    if (!wld.get<ReactiveMode>()) {
+        redraw.needed = true;
+    }
+
+    if (auto win = wld.get<GLFWwindow*>()) {
+        render_wld.insert(*win);
+    }
+
+    if (auto pbuffer = wld.get<EglPbuffer>()) {
+        render_wld.insert(pbuffer);
+    }
+
+    if (auto info = wld.get<WindowInfo>()) {
+        auto last_info = render_wld.get<WindowInfo>();
+
+        if (!last_info || last_info->width != info->width
+            || last_info->height != info->height) {
+            redraw.needed = true;
+        }
+
+        render_wld.insert(*info);
+    }
+}
+
+static bool frame_drawn(World& render_wld)
+{
+    auto redraw = render_wld.get<Redraw>();
+
+    return !redraw || redraw->needed;
+}
+
+static void begin_frame_system(World& render_wld)
+{
+    if (auto win = render_wld.get<GLFWwindow*>()) {
+        if (glfwGetCurrentContext() != *win) {
+            glfwMakeContextCurrent(*win);
+        }
+    } else if (auto pbuffer = render_wld.get<EglPbuffer*>()) {
+        (*pbuffer)->make_current();
+    } else {
+        return;
+    }
+
+#ifdef IGE_OPENGL
+    if (auto info = render_wld.get<WindowInfo>()) {
+        if (frame_drawn(render_wld)) {
+            glViewport(0, 0, info->width, info->height);
+        }
+    }
+#endif
+}
 
+static void present_system(World& render_wld)
+{
+    auto win = render_wld.get<GLFWwindow*>();
+
+    // pbuffers have nothing to swap
+    if (win && frame_drawn(render_wld)) {
         glfwSwapBuffers(*win);
     }
+
+    if (auto redraw = render_wld.get<Redraw>()) {
+        redraw->needed = false;
+    }
+}
+
+static void release_context_system(World& render_wld)
+{
+    if (auto win = render_wld.get<GLFWwindow*>()) {
+        if (glfwGetCurrentContext() == *win) {
+            glfwMakeContextCurrent(nullptr);
+        }
+    }
+
+    if (auto pbuffer = render_wld.get<EglPbuffer*>()) {
+        (*pbuffer)->release();
+    }
 }
 
-static void poll_events_system(World&)
+static void poll_events_system(World& wld)
 {
-    glfwPollEvents();
+    auto reactive = wld.get<ReactiveMode>();
+
+    if (reactive && !reactive->update_requested) {
+        glfwWaitEventsTimeout(reactive->timeout);
+    } else {
+        glfwPollEvents();
+    }
+
+    if (reactive) {
+        reactive->update_requested = false;
+    }
+
+    // input callbacks queue events during polling, deliver them right away
+    flush_event_channel<InputEvent>(wld);
 }
 
 static void update_gamepads(World& wld)
@@ -360,11 +538,17 @@ static void update_gamepads(World& wld)
 void WindowPlugin::plug(App::Builder& builder) const
 {
     builder.emplace<EventChannel<WindowEvent>>();
+    builder.emplace<MpscEventChannel<WindowEvent>>();
     builder.add_startup_system(System::from(init_glfw_system));
     builder.add_startup_system(System::from(create_window_system));
     builder.add_cleanup_system(System::from(destroy_window_system));
     builder.add_cleanup_system(System::from(terminate_glfw_system));
     builder.add_system(System::from(update_window_system));
     builder.add_system(System::from(poll_events_system));
+    builder.add_system(System::from(flush_event_channel<WindowEvent>));
     builder.add_system(System::from(update_gamepads));
+    builder.add_extract_system(System::from(extract_window_system));
+    builder.add_begin_frame_system(System::from(begin_frame_system));
+    builder.add_present_system(System::from(present_system));
+    builder.add_render_cleanup_system(System::from(release_context_system));
 }
@@ -0,0 +1,135 @@
+#include "igepch.hpp"
+
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/render/InheritedVisibility.hpp"
+#include "plugin/transform/TransformHierarchy.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+using ige::ecs::EntityId;
+using ige::ecs::World;
+using ige::plugin::render::InheritedVisibility;
+using ige::plugin::render::Visibility;
+
+bool InheritedVisibility::changed(World& world)
+{
+    auto hierarchy = world.get<TransformHierarchy>();
+    auto visibilities = world.get_component_storage<Visibility>();
+    std::pair<std::uint64_t, std::uint64_t> versions {
+        hierarchy ? hierarchy->version() : 0,
+        visibilities ? visibilities->version() : 0,
+    };
+
+    // `Visibility` fields are modified in place, without bumping the version
+    m_next_locals.clear();
+
+    for (auto [entity, vis] : world.query<Visibility>()) {
+        m_next_locals.push_back({ vis.visible, vis.opacity });
+    }
+
+    if (versions == m_versions && m_next_locals == m_locals) {
+        return false;
+    }
+
+    m_versions = versions;
+    std::swap(m_locals, m_next_locals);
+
+    return true;
+}
+
+void InheritedVisibility::update(World& world)
+{
+    if (!changed(world)) {
+        return;
+    }
+
+    std::fill(m_hidden.begin(), m_hidden.end(), false);
+    m_opacity.clear();
+    m_roots.clear();
+
+    auto hierarchy = world.get<TransformHierarchy>();
+
+    for (auto [entity, vis] : world.query<Visibility>()) {
+        // overwritten below for entities under another `Visibility`
+        vis.force_global_update(true, 1.0f);
+
+        if (hierarchy) {
+            if (auto node = hierarchy->node_of(entity)) {
+                m_roots.push_back(*node);
+            }
+        }
+    }
+
+    if (m_roots.empty()) {
+        return;
+    }
+
+    auto visibilities = world.get_component_storage<Visibility>();
+    const auto& nodes = hierarchy->nodes();
+
+    // ancestors come first, and their subtree contains the nested ones
+    std::sort(m_roots.begin(), m_roots.end());
+
+    std::size_t visited_end = 0;
+
+    for (std::size_t root : m_roots) {
+        if (root < visited_end) {
+            continue;
+        }
+
+        visited_end = nodes[root].subtree_end;
+        m_states.resize(visited_end - root);
+
+        for (std::size_t i = root; i < visited_end; i++) {
+            const auto& node = nodes[i];
+
+            // nothing above the first `Visibility` of a subtree
+            State state { true, 1.0f };
+
+            if (i != root) {
+                state = m_states[node.parent - root];
+            }
+
+            if (auto vis = visibilities->get(node.entity.index())) {
+                vis->force_global_update(state.visible, state.opacity);
+                state = { vis->global_visible(), vis->global_opacity() };
+            } else if (!state.visible || state.opacity != 1.0f) {
+                set(node.entity, state);
+            }
+
+            m_states[i - root] = state;
+        }
+    }
+}
+
+bool InheritedVisibility::visible(EntityId entity) const
+{
+    std::size_t index = entity.index();
+
+    return index >= m_hidden.size() || !m_hidden[index];
+}
+
+float InheritedVisibility::opacity(EntityId entity) const
+{
+    auto it = m_opacity.find(entity.index());
+
+    return it != m_opacity.end() ? it->second : 1.0f;
+}
+
+void InheritedVisibility::set(EntityId entity, State state)
+{
+    std::size_t index = entity.index();
+
+    if (!state.visible) {
+        if (index >= m_hidden.size()) {
+            m_hidden.resize(index + 1, false);
+        }
+
+        m_hidden[index] = true;
+    } else {
+        m_opacity[index] = state.opacity;
+    }
+}
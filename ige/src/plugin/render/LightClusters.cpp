@@ -0,0 +1,205 @@
+#include "igepch.hpp"
+
+#include "ige/core/Bounds.hpp"
+#include "ige/plugin/render/LightClusters.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+#if defined(__SSE__) || defined(_M_X64)                                        \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define IGE_CLUSTERS_SSE
+#include <xmmintrin.h>
+#endif
+
+using ige::core::BoundingSphere;
+using ige::plugin::render::LightClusters;
+
+// planes through the camera, at regular intervals in normalized device
+// coordinates: `n` is the component of the normal along the split axis
+template <std::size_t N>
+static void split_planes(
+    std::size_t count, float tan_half_fov, std::array<float, N>& n,
+    std::array<float, N>& z)
+{
+    for (std::size_t i = 0; i < N; i++) {
+        float ndc = -1.0f + 2.0f * float(i) / float(count);
+        float slope = ndc * tan_half_fov;
+        float length = std::sqrt(1.0f + slope * slope);
+
+        n[i] = 1.0f / length;
+        z[i] = slope / length;
+    }
+}
+
+// bit `i` of `ahead` is set when the sphere isn't entirely behind plane `i`,
+// and bit `i` of `behind` when it isn't entirely in front of it
+template <std::size_t N>
+static void plane_masks(
+    const std::array<float, N>& n, const std::array<float, N>& z,
+    float center_n, float center_z, float radius, std::uint32_t& ahead,
+    std::uint32_t& behind)
+{
+    static_assert(N % 4 == 0 && N <= 32);
+
+    ahead = 0;
+    behind = 0;
+
+#ifdef IGE_CLUSTERS_SSE
+    const __m128 cn = _mm_set1_ps(center_n);
+    const __m128 cz = _mm_set1_ps(center_z);
+    const __m128 r = _mm_set1_ps(radius);
+    const __m128 neg_r = _mm_set1_ps(-radius);
+
+    for (std::size_t i = 0; i < N; i += 4) {
+        const __m128 d = _mm_add_ps(
+            _mm_mul_ps(_mm_loadu_ps(&n[i]), cn),
+            _mm_mul_ps(_mm_loadu_ps(&z[i]), cz));
+
+        ahead |= std::uint32_t(_mm_movemask_ps(_mm_cmpge_ps(d, neg_r))) << i;
+        behind |= std::uint32_t(_mm_movemask_ps(_mm_cmple_ps(d, r))) << i;
+    }
+#else
+    for (std::size_t i = 0; i < N; i++) {
+        float d = n[i] * center_n + z[i] * center_z;
+
+        ahead |= std::uint32_t(d >= -radius) << i;
+        behind |= std::uint32_t(d <= radius) << i;
+    }
+#endif
+}
+
+// tiles between two planes the sphere isn't entirely outside of
+static std::uint32_t
+tile_mask(std::uint32_t ahead, std::uint32_t behind, std::size_t tiles)
+{
+    return ahead & (behind >> 1) & ((std::uint32_t(1) << tiles) - 1);
+}
+
+void LightClusters::set_projection(
+    float fov_y, float aspect, float near, float far)
+{
+    float tan_y = std::tan(fov_y * 0.5f);
+
+    split_planes(TILES_X, tan_y * aspect, m_column_x, m_column_z);
+    split_planes(TILES_Y, tan_y, m_row_y, m_row_z);
+
+    m_near = near;
+    m_far = far;
+    m_slice_scale = float(SLICES) / std::log(far / near);
+}
+
+std::size_t
+LightClusters::index(std::size_t x, std::size_t y, std::size_t slice)
+{
+    return (slice * TILES_Y + y) * TILES_X + x;
+}
+
+std::size_t LightClusters::slice(float depth) const
+{
+    if (depth <= m_near) {
+        return 0;
+    }
+
+    auto slice = static_cast<std::size_t>(
+        std::floor(std::log(depth / m_near) * m_slice_scale));
+
+    return std::min(slice, SLICES - 1);
+}
+
+void LightClusters::assign(std::span<const BoundingSphere> lights)
+{
+    m_pairs.clear();
+
+    for (std::uint32_t light = 0; light < lights.size(); light++) {
+        const auto& [center, radius] = lights[light];
+
+        // the camera looks down -z
+        float depth = -center.z;
+
+        if (depth + radius < m_near || depth - radius > m_far) {
+            continue;
+        }
+
+        std::uint32_t ahead;
+        std::uint32_t behind;
+
+        plane_masks(
+            m_column_x, m_column_z, center.x, center.z, radius, ahead, behind);
+        std::uint32_t columns = tile_mask(ahead, behind, TILES_X);
+
+        plane_masks(
+            m_row_y, m_row_z, center.y, center.z, radius, ahead, behind);
+        std::uint32_t rows = tile_mask(ahead, behind, TILES_Y);
+
+        if (columns == 0 || rows == 0) {
+            continue;
+        }
+
+        std::size_t first_slice = slice(depth - radius);
+        std::size_t last_slice = slice(depth + radius);
+
+        for (std::size_t s = first_slice; s <= last_slice; s++) {
+            for (std::size_t y = 0; y < TILES_Y; y++) {
+                if ((rows & (1 << y)) == 0) {
+                    continue;
+                }
+
+                for (std::size_t x = 0; x < TILES_X; x++) {
+                    if (columns & (1 << x)) {
+                        m_pairs.push_back(
+                            std::uint64_t(index(x, y, s)) << 32 | light);
+                    }
+                }
+            }
+        }
+    }
+
+    // count the lights of each cluster, then fill them in place
+    for (Cluster& cluster : m_clusters) {
+        cluster = {};
+    }
+
+    for (std::uint64_t pair : m_pairs) {
+        m_clusters[pair >> 32].count++;
+    }
+
+    std::uint32_t offset = 0;
+
+    for (Cluster& cluster : m_clusters) {
+        cluster.offset = offset;
+        offset += cluster.count;
+        cluster.count = 0;
+    }
+
+    m_indices.resize(m_pairs.size());
+
+    for (std::uint64_t pair : m_pairs) {
+        Cluster& cluster = m_clusters[pair >> 32];
+
+        m_indices[cluster.offset + cluster.count++]
+            = static_cast<std::uint32_t>(pair);
+    }
+}
+
+float LightClusters::near() const
+{
+    return m_near;
+}
+
+float LightClusters::slice_scale() const
+{
+    return m_slice_scale;
+}
+
+std::span<const LightClusters::Cluster> LightClusters::clusters() const
+{
+    return m_clusters;
+}
+
+std::span<const std::uint32_t> LightClusters::indices() const
+{
+    return m_indices;
+}
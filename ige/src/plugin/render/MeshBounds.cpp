@@ -0,0 +1,57 @@
+#include "igepch.hpp"
+
+#include "MeshBounds.hpp"
+#include "ige/asset/Mesh.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include <cstdint>
+#include <utility>
+
+using ige::asset::Mesh;
+using ige::ecs::World;
+using ige::plugin::render::MeshRenderer;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::WorldBounds;
+
+void MeshBounds::update(World& world)
+{
+    auto renderers = world.get_component_storage<MeshRenderer>();
+    auto transforms = world.get_component_storage<Transform>();
+    std::pair<std::uint64_t, std::uint64_t> versions {
+        renderers ? renderers->version() : 0,
+        transforms ? transforms->version() : 0,
+    };
+
+    if (versions == m_versions) {
+        return;
+    }
+
+    m_versions = versions;
+
+    for (auto [entity, renderer, xform] :
+         world.query<MeshRenderer, Transform>()) {
+        if (!renderer.mesh) {
+            continue;
+        }
+
+        const Mesh& mesh = *renderer.mesh;
+        auto bounds = world.get_component<WorldBounds>(entity);
+
+        if (bounds && bounds->mesh() == &mesh
+            && bounds->local_aabb() == mesh.bounds()
+            && bounds->local_sphere() == mesh.bounding_sphere()) {
+            continue;
+        }
+
+        world
+            .emplace_component<WorldBounds>(
+                entity, mesh.bounds(), mesh.bounding_sphere(), &mesh)
+            .force_update(xform.local_to_world());
+    }
+}
+
+void MeshBounds::invalidate()
+{
+    m_versions.reset();
+}
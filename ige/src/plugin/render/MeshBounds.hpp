@@ -0,0 +1,34 @@
+#ifndef E0A582AC_B5A2_4E9B_8DDA_84ADA2150453
+#define E0A582AC_B5A2_4E9B_8DDA_84ADA2150453
+
+#include "igepch.hpp"
+
+#include "ige/ecs/World.hpp"
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief Keeps a `WorldBounds` on every entity with a `MeshRenderer` and a
+ * `Transform`, matching the bounds of its mesh.
+ *
+ * Entities are only visited when `MeshRenderer` or `Transform` components were
+ * added or replaced since the last update, or after `invalidate`. Afterwards,
+ * the transform hierarchy keeps the world bounds up to date.
+ */
+class MeshBounds {
+public:
+    void update(ige::ecs::World&);
+
+    /**
+     * @brief Visit every entity during the next update, e.g. because the mesh
+     * of a `MeshRenderer` was swapped in place.
+     */
+    void invalidate();
+
+private:
+    // `MeshRenderer` and `Transform` storage versions of the last update
+    std::optional<std::pair<std::uint64_t, std::uint64_t>> m_versions;
+};
+
+#endif /* E0A582AC_B5A2_4E9B_8DDA_84ADA2150453 */
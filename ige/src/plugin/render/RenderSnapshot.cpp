@@ -0,0 +1,231 @@
+#include "igepch.hpp"
+
+#include "MeshBounds.hpp"
+#include "RenderSnapshot.hpp"
+#include "ige/asset/Material.hpp"
+#include "ige/asset/Mesh.hpp"
+#include "ige/asset/Skeleton.hpp"
+#include "ige/core/App.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/AnimationPlugin.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "ige/plugin/WindowPlugin.hpp"
+#include "ige/plugin/render/InheritedVisibility.hpp"
+#include <unordered_map>
+
+using glm::vec4;
+using ige::asset::Material;
+using ige::asset::Mesh;
+using ige::core::MainWorld;
+using ige::ecs::World;
+using ige::plugin::animation::SkeletonPose;
+using ige::plugin::render::ImageRenderer;
+using ige::plugin::render::InheritedVisibility;
+using ige::plugin::render::Light;
+using ige::plugin::render::MeshRenderer;
+using ige::plugin::render::PerspectiveCamera;
+using ige::plugin::render::RectRenderer;
+using ige::plugin::render::Visibility;
+using ige::plugin::transform::RectTransform;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::WorldBounds;
+using ige::plugin::window::ReactiveMode;
+using ige::plugin::window::Redraw;
+
+void RenderSnapshot::clear()
+{
+    camera.reset();
+    meshes.clear();
+    joint_matrices.clear();
+    lights.clear();
+    ui.clear();
+}
+
+// offset of each skeleton's palette in `RenderSnapshot::joint_matrices`
+using Palettes = std::unordered_map<const SkeletonPose*, std::size_t>;
+
+static void extract_skin(
+    World& world, RenderSnapshot& snapshot, RenderSnapshot::MeshDraw& draw,
+    const MeshRenderer& renderer, Palettes& palettes)
+{
+    if (!renderer.skeleton_pose || !renderer.mesh->attr_joints()
+        || !renderer.mesh->attr_weights()) {
+        return;
+    }
+
+    auto pose = world.get_component<SkeletonPose>(*renderer.skeleton_pose);
+
+    if (!pose) {
+        std::cerr << "[WARN] Missing SkeletonPose" << std::endl;
+        return;
+    }
+
+    const auto& skeleton = *pose->skeleton;
+
+    draw.joint_count = skeleton.joints.size();
+
+    // primitives of the same model share their skeleton's palette
+    auto [palette, inserted]
+        = palettes.try_emplace(pose, snapshot.joint_matrices.size());
+    draw.joint_offset = palette->second;
+
+    if (!inserted) {
+        return;
+    }
+
+    // compute joint matrices:
+    // jointMatrix[j] =
+    //        inverse(globalTransform)
+    //      * globalJointTransform[j]
+    //      * inverseBindMatrix[j];
+    for (std::size_t j = 0; j < draw.joint_count; j++) {
+        // TODO: figure out why the inverse global transform is a lie
+        snapshot.joint_matrices.push_back(
+            pose->global_pose[j] * skeleton.joints[j].inv_bind_matrix);
+    }
+}
+
+static void extract_scene(World& world, RenderSnapshot& snapshot)
+{
+    auto cameras = world.query<PerspectiveCamera, Transform>();
+
+    if (!cameras.empty()) {
+        auto& [entity, camera, xform] = cameras[0];
+
+        snapshot.camera = { camera, xform.world_to_local() };
+    }
+
+    Palettes palettes;
+
+    for (auto& [entity, renderer, xform] :
+         world.query<MeshRenderer, Transform>()) {
+        if (!renderer.mesh) {
+            continue;
+        }
+
+        auto& draw = snapshot.meshes.emplace_back();
+        draw.mesh = renderer.mesh;
+        draw.material = renderer.material;
+        draw.model = xform.local_to_world();
+
+        if (renderer.material) {
+            draw.double_sided = renderer.material->double_sided();
+            draw.base_color_factor = renderer.material->get_or(
+                "base_color_factor", vec4(1.0f));
+
+            auto base_texture = renderer.material->get("base_color_texture");
+            if (base_texture
+                && base_texture->type == Material::ParameterType::TEXTURE) {
+                draw.base_color_texture = base_texture->texture;
+            }
+        }
+
+        extract_skin(world, snapshot, draw, renderer, palettes);
+
+        // skinned meshes can move out of the bounds of their bind pose
+        auto bounds = world.get_component<WorldBounds>(entity);
+
+        if (!bounds || draw.joint_count != 0) {
+            continue;
+        }
+
+        const Mesh& mesh = *renderer.mesh;
+
+        if (bounds->mesh() == &mesh) {
+            draw.bounds = bounds->aabb();
+            continue;
+        }
+
+        // the mesh was swapped in place: the next update fixes `WorldBounds`
+        WorldBounds fresh(mesh.bounds(), mesh.bounding_sphere(), &mesh);
+        fresh.force_update(draw.model);
+        draw.bounds = fresh.aabb();
+
+        if (auto mesh_bounds = world.get<MeshBounds>()) {
+            mesh_bounds->invalidate();
+        }
+    }
+
+    for (auto& [entity, light] : world.query<Light>()) {
+        auto& draw = snapshot.lights.emplace_back();
+        draw.light = light;
+
+        if (auto xform = world.get_component<Transform>(entity)) {
+            draw.model = xform->local_to_world();
+        }
+    }
+}
+
+template <typename R>
+static void extract_ui_elements(World& world, RenderSnapshot& snapshot)
+{
+    auto inherited = world.get<InheritedVisibility>();
+
+    for (auto& [entity, renderer, xform] : world.query<R, RectTransform>()) {
+        bool visible = true;
+        float opacity = 1.0f;
+
+        if (auto vis = world.get_component<Visibility>(entity)) {
+            visible = vis->global_visible();
+            opacity = vis->global_opacity();
+        } else if (inherited) {
+            visible = inherited->visible(entity);
+            opacity = inherited->opacity(entity);
+        }
+
+        if (!visible || opacity == 0.0f) {
+            continue;
+        }
+
+        snapshot.ui.push_back({
+            renderer,
+            xform.abs_bounds_min(),
+            xform.abs_bounds_max(),
+            xform.abs_depth(),
+            opacity,
+        });
+    }
+}
+
+static void extract_ui(World& world, RenderSnapshot& snapshot)
+{
+    extract_ui_elements<RectRenderer>(world, snapshot);
+    extract_ui_elements<ImageRenderer>(world, snapshot);
+
+    std::sort(
+        snapshot.ui.begin(), snapshot.ui.end(),
+        [](const RenderSnapshot::UiDraw& a, const RenderSnapshot::UiDraw& b) {
+            return a.depth > b.depth;
+        });
+}
+
+struct PreviousRenderSnapshot {
+    RenderSnapshot snapshot;
+};
+
+void extract_render_snapshot(World& render_world)
+{
+    World& world = render_world.get<MainWorld>()->get();
+    auto reactive = world.get<ReactiveMode>();
+    auto& snapshot = render_world.get_or_emplace<RenderSnapshot>();
+    PreviousRenderSnapshot* previous = nullptr;
+
+    // in reactive mode, keep the last snapshot around to tell whether the
+    // frame changed, reusing its storage for the next one
+    if (reactive) {
+        previous = &render_world.get_or_emplace<PreviousRenderSnapshot>();
+        std::swap(snapshot, previous->snapshot);
+    }
+
+    snapshot.clear();
+    extract_scene(world, snapshot);
+    extract_ui(world, snapshot);
+
+    if (previous && snapshot != previous->snapshot) {
+        render_world.get_or_emplace<Redraw>().needed = true;
+
+        // things are moving: keep updating until they stop
+        reactive->update_requested = true;
+    }
+}
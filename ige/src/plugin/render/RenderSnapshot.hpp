@@ -0,0 +1,97 @@
+#ifndef A55AD822_F239_4025_A1F4_39036E430573
+#define A55AD822_F239_4025_A1F4_39036E430573
+
+#include "igepch.hpp"
+
+#include "ige/asset/Material.hpp"
+#include "ige/asset/Mesh.hpp"
+#include "ige/asset/Texture.hpp"
+#include "ige/core/Bounds.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include <cstddef>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <optional>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Everything the renderers need to draw a frame.
+ *
+ * It is filled by an extract system at the end of the simulation and lives in
+ * the render world, so render systems never touch simulation components. It
+ * must be treated as immutable by render systems.
+ */
+struct RenderSnapshot {
+    struct Camera {
+        ige::plugin::render::PerspectiveCamera params;
+        glm::mat4 view;
+
+        bool operator==(const Camera&) const = default;
+    };
+
+    struct MeshDraw {
+        ige::asset::Mesh::Handle mesh;
+        ige::asset::Material::Handle material;
+        glm::mat4 model;
+
+        // material parameters, resolved during extraction
+        glm::vec4 base_color_factor { 1.0f };
+        ige::asset::Texture::Handle base_color_texture;
+        bool double_sided = false;
+
+        // range in `RenderSnapshot::joint_matrices` (skinned meshes only),
+        // shared by the meshes animated by the same skeleton
+        std::size_t joint_offset = 0;
+        std::size_t joint_count = 0;
+
+        // world space bounds, meshes without any are never culled
+        std::optional<ige::core::Aabb> bounds;
+
+        bool operator==(const MeshDraw&) const = default;
+    };
+
+    struct LightDraw {
+        ige::plugin::render::Light light;
+        glm::mat4 model { 1.0f };
+
+        bool operator==(const LightDraw&) const = default;
+    };
+
+    struct UiDraw {
+        std::variant<
+            ige::plugin::render::RectRenderer,
+            ige::plugin::render::ImageRenderer>
+            renderer;
+        glm::vec2 bounds_min;
+        glm::vec2 bounds_max;
+        float depth = 0.0f;
+        float opacity = 1.0f;
+
+        bool operator==(const UiDraw&) const = default;
+    };
+
+    std::optional<Camera> camera;
+    std::vector<MeshDraw> meshes;
+    std::vector<glm::mat4> joint_matrices;
+    std::vector<LightDraw> lights;
+
+    // sorted back to front
+    std::vector<UiDraw> ui;
+
+    void clear();
+
+    bool operator==(const RenderSnapshot&) const = default;
+};
+
+/**
+ * @brief Extract system filling the `RenderSnapshot` of the render world.
+ *
+ * In reactive mode, the frame is only redrawn if the snapshot differs from the
+ * previous one.
+ */
+void extract_render_snapshot(ige::ecs::World& render_world);
+
+#endif /* A55AD822_F239_4025_A1F4_39036E430573 */
@@ -50,6 +50,15 @@ void Buffer::bind_base(
         static_cast<GLenum>(target), binding_point_index, buffer.id());
 }
 
+void Buffer::bind_range(
+    Target target, GLuint binding_point_index, const Buffer& buffer,
+    GLintptr offset, GLsizeiptr size)
+{
+    glBindBufferRange(
+        static_cast<GLenum>(target), binding_point_index, buffer.id(), offset,
+        size);
+}
+
 void Buffer::unbind(Target target)
 {
     glBindBuffer(static_cast<GLenum>(target), 0);
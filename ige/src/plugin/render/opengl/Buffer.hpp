@@ -54,6 +54,9 @@ public:
 
     static void bind(Target, const Buffer&);
     static void bind_base(Target, GLuint binding_point_index, const Buffer&);
+    static void bind_range(
+        Target, GLuint binding_point_index, const Buffer&, GLintptr offset,
+        GLsizeiptr size);
     static void unbind(Target);
     static void data(Target, GLsizeiptr size, const void* data, Usage);
     static void
@@ -100,6 +100,11 @@ bool MeshCache::has_skin() const
     return m_has_skin;
 }
 
+gl::VertexArray& MeshCache::vertex_array()
+{
+    return m_vertex_array;
+}
+
 const gl::VertexArray& MeshCache::vertex_array() const
 {
     return m_vertex_array;
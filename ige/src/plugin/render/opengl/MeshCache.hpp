@@ -12,6 +12,7 @@ public:
     ~MeshCache();
 
     bool has_skin() const;
+    gl::VertexArray& vertex_array();
     const gl::VertexArray& vertex_array() const;
     const gl::Buffer& index_buffer() const;
     std::span<const gl::Buffer> vertex_buffers() const;
@@ -3,11 +3,16 @@
 #include "Program.hpp"
 #include "Shader.hpp"
 #include "glad/gl.h"
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using gl::Program;
 using gl::Shader;
 using gl::Texture;
+using gl::UniformId;
 using glm::mat2;
 using glm::mat3;
 using glm::mat4;
@@ -15,6 +20,21 @@ using glm::vec2;
 using glm::vec3;
 using glm::vec4;
 
+UniformId::UniformId(GLint location)
+    : m_location(location)
+{
+}
+
+bool UniformId::valid() const
+{
+    return m_location != -1;
+}
+
+GLint UniformId::location() const
+{
+    return m_location;
+}
+
 Program::LinkError::LinkError(const char* info_log)
     : std::runtime_error(info_log)
 {
@@ -43,6 +63,7 @@ Program& Program::operator=(Program&& other)
     }
 
     m_id = other.m_id;
+    m_uniforms = std::move(other.m_uniforms);
     other.m_id = 0;
     return *this;
 }
@@ -89,6 +110,49 @@ void Program::link()
         glDeleteProgram(m_id);
         throw Program::LinkError(log.c_str());
     }
+
+    reflect_uniforms();
+}
+
+void Program::reflect_uniforms()
+{
+    m_uniforms.clear();
+
+    GLint count = 0;
+    GLint max_length = 0;
+
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+    std::vector<char> name(std::max(max_length, 1));
+
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+
+        glGetActiveUniform(
+            m_id, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+            &length, &size, &type, name.data());
+
+        std::string uniform_name(name.data(), length);
+        GLint location = glGetUniformLocation(m_id, uniform_name.c_str());
+
+        // members of uniform blocks have no location
+        if (location == -1) {
+            continue;
+        }
+
+        // arrays are reported as "name[0]"
+        if (uniform_name.ends_with("[0]")) {
+            m_uniforms.emplace_back(
+                uniform_name.substr(0, uniform_name.size() - 3), location);
+        }
+
+        m_uniforms.emplace_back(std::move(uniform_name), location);
+    }
+
+    std::sort(m_uniforms.begin(), m_uniforms.end());
 }
 
 void Program::link(const Shader& vs, const Shader& fs)
@@ -118,9 +182,29 @@ GLuint Program::id() const
     return m_id;
 }
 
+UniformId Program::uniform_id(std::string_view name) const
+{
+    auto it = std::lower_bound(
+        m_uniforms.begin(), m_uniforms.end(), name,
+        [](const auto& uniform, std::string_view name) {
+            return uniform.first < name;
+        });
+
+    if (it != m_uniforms.end() && it->first == name) {
+        return UniformId(it->second);
+    }
+
+    // other elements of arrays aren't in the table
+    if (name.find('[') != std::string_view::npos) {
+        return UniformId(glGetUniformLocation(m_id, std::string(name).c_str()));
+    }
+
+    return UniformId();
+}
+
 GLuint Program::uniform(const char* name) const
 {
-    return glGetUniformLocation(m_id, name);
+    return uniform_id(name).location();
 }
 
 GLuint Program::uniform_block(const char* name) const
@@ -130,146 +214,214 @@ GLuint Program::uniform_block(const char* name) const
 
 void Program::uniform(const char* name, int value)
 {
-    use();
-    glUniform1i(uniform(name), value);
+    uniform(uniform_id(name), value);
 }
 
 void Program::uniform(const char* name, std::span<const int> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, float value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const float> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, const vec2& value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const vec2> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, const vec3& value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const vec3> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, const vec4& value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const vec4> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, const mat2& value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const mat2> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, const mat3& value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const mat3> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(const char* name, const mat4& value)
+{
+    uniform(uniform_id(name), value);
+}
+
+void Program::uniform(const char* name, std::span<const mat4> values)
+{
+    uniform(uniform_id(name), values);
+}
+
+void Program::uniform(UniformId id, int value)
+{
+    glProgramUniform1i(m_id, id.location(), value);
+}
+
+void Program::uniform(UniformId id, std::span<const int> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniform1iv(
-        uniform(name), static_cast<GLsizei>(values.size()),
+    glProgramUniform1iv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()),
         reinterpret_cast<const GLint*>(values.data()));
 }
 
-void Program::uniform(const char* name, float value)
+void Program::uniform(UniformId id, float value)
 {
-    use();
-    glUniform1f(uniform(name), value);
+    glProgramUniform1f(m_id, id.location(), value);
 }
 
-void Program::uniform(const char* name, std::span<const float> values)
+void Program::uniform(UniformId id, std::span<const float> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniform1fv(
-        uniform(name), static_cast<GLsizei>(values.size()), values.data());
+    glProgramUniform1fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()),
+        values.data());
 }
 
-void Program::uniform(const char* name, const vec2& value)
+void Program::uniform(UniformId id, const vec2& value)
 {
-    use();
-    glUniform2f(uniform(name), value.x, value.y);
+    glProgramUniform2f(m_id, id.location(), value.x, value.y);
 }
 
-void Program::uniform(const char* name, std::span<const vec2> values)
+void Program::uniform(UniformId id, std::span<const vec2> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniform2fv(
-        uniform(name), static_cast<GLsizei>(values.size()),
+    glProgramUniform2fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()),
         reinterpret_cast<const GLfloat*>(values.data()));
 }
 
-void Program::uniform(const char* name, const vec3& value)
+void Program::uniform(UniformId id, const vec3& value)
 {
-    use();
-    glUniform3f(uniform(name), value.x, value.y, value.z);
+    glProgramUniform3f(m_id, id.location(), value.x, value.y, value.z);
 }
 
-void Program::uniform(const char* name, std::span<const vec3> values)
+void Program::uniform(UniformId id, std::span<const vec3> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniform3fv(
-        uniform(name), static_cast<GLsizei>(values.size()),
+    glProgramUniform3fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()),
         reinterpret_cast<const GLfloat*>(values.data()));
 }
 
-void Program::uniform(const char* name, const vec4& value)
+void Program::uniform(UniformId id, const vec4& value)
 {
-    use();
-    glUniform4f(uniform(name), value.x, value.y, value.z, value.w);
+    glProgramUniform4f(
+        m_id, id.location(), value.x, value.y, value.z, value.w);
 }
 
-void Program::uniform(const char* name, std::span<const vec4> values)
+void Program::uniform(UniformId id, std::span<const vec4> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniform4fv(
-        uniform(name), static_cast<GLsizei>(values.size()),
+    glProgramUniform4fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()),
         reinterpret_cast<const GLfloat*>(values.data()));
 }
 
-void Program::uniform(const char* name, const mat2& value)
+void Program::uniform(UniformId id, const mat2& value)
 {
-    uniform(name, std::span(&value, 1));
+    uniform(id, std::span(&value, 1));
 }
 
-void Program::uniform(const char* name, std::span<const mat2> values)
+void Program::uniform(UniformId id, std::span<const mat2> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniformMatrix2fv(
-        uniform(name), static_cast<GLsizei>(values.size()), GL_FALSE,
+    glProgramUniformMatrix2fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()), GL_FALSE,
         reinterpret_cast<const GLfloat*>(glm::value_ptr(values.front())));
 }
 
-void Program::uniform(const char* name, const mat3& value)
+void Program::uniform(UniformId id, const mat3& value)
 {
-    uniform(name, std::span(&value, 1));
+    uniform(id, std::span(&value, 1));
 }
 
-void Program::uniform(const char* name, std::span<const mat3> values)
+void Program::uniform(UniformId id, std::span<const mat3> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniformMatrix3fv(
-        uniform(name), static_cast<GLsizei>(values.size()), GL_FALSE,
+    glProgramUniformMatrix3fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()), GL_FALSE,
         reinterpret_cast<const GLfloat*>(glm::value_ptr(values.front())));
 }
 
-void Program::uniform(const char* name, const mat4& value)
+void Program::uniform(UniformId id, const mat4& value)
 {
-    uniform(name, std::span(&value, 1));
+    uniform(id, std::span(&value, 1));
 }
 
-void Program::uniform(const char* name, std::span<const mat4> values)
+void Program::uniform(UniformId id, std::span<const mat4> values)
 {
     if (values.empty()) {
         return;
     }
 
-    use();
-    glUniformMatrix4fv(
-        uniform(name), static_cast<GLsizei>(values.size()), GL_FALSE,
+    glProgramUniformMatrix4fv(
+        m_id, id.location(), static_cast<GLsizei>(values.size()), GL_FALSE,
         reinterpret_cast<const GLfloat*>(glm::value_ptr(values.front())));
 }
 
 void Program::uniform_block(const char* name, GLuint uniform_block_binding)
 {
-    use();
     glUniformBlockBinding(m_id, uniform_block(name), uniform_block_binding);
 }
@@ -6,9 +6,35 @@
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "glad/gl.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace gl {
 
+/**
+ * @brief Location of a uniform of a `Program`, looked up once with
+ * `Program::uniform_id`.
+ *
+ * Ids of uniforms missing from the program (or optimized out) can still be
+ * set, it just doesn't do anything.
+ */
+class UniformId {
+public:
+    UniformId() = default;
+
+    bool valid() const;
+    GLint location() const;
+
+private:
+    friend class Program;
+
+    explicit UniformId(GLint location);
+
+    GLint m_location = -1;
+};
+
 class Program {
 public:
     class LinkError : public std::runtime_error {
@@ -29,12 +55,28 @@ public:
     void detach(const Shader&);
     void link(const Shader&, const Shader&);
     void link();
+
+    /**
+     * @brief Make this program the current one.
+     *
+     * Redundant calls are skipped by going through a `gl::StateCache`, which
+     * lives with the renderer (and its context) instead of the process.
+     */
     void use() const;
     GLuint id() const;
 
+    /**
+     * @brief Find a uniform by name in the table built when linking.
+     *
+     * Arrays can be found with or without the `[0]` suffix. Resolve ids once
+     * after linking, and set uniforms with them in hot loops.
+     */
+    UniformId uniform_id(std::string_view name) const;
+
     GLuint uniform(const char* name) const;
     GLuint uniform_block(const char* name) const;
 
+    // setting uniforms doesn't need the program to be in use
     void uniform(const char* name, int);
     void uniform(const char* name, std::span<const int>);
     void uniform(const char* name, float);
@@ -52,10 +94,32 @@ public:
     void uniform(const char* name, const glm::mat4&);
     void uniform(const char* name, std::span<const glm::mat4>);
 
+    void uniform(UniformId, int);
+    void uniform(UniformId, std::span<const int>);
+    void uniform(UniformId, float);
+    void uniform(UniformId, std::span<const float>);
+    void uniform(UniformId, const glm::vec2&);
+    void uniform(UniformId, std::span<const glm::vec2>);
+    void uniform(UniformId, const glm::vec3&);
+    void uniform(UniformId, std::span<const glm::vec3>);
+    void uniform(UniformId, const glm::vec4&);
+    void uniform(UniformId, std::span<const glm::vec4>);
+    void uniform(UniformId, const glm::mat2&);
+    void uniform(UniformId, std::span<const glm::mat2>);
+    void uniform(UniformId, const glm::mat3&);
+    void uniform(UniformId, std::span<const glm::mat3>);
+    void uniform(UniformId, const glm::mat4&);
+    void uniform(UniformId, std::span<const glm::mat4>);
+
     void uniform_block(const char* name, GLuint uniform_block_binding);
 
 private:
     GLuint m_id = 0;
+
+    // active uniforms of the default block and their location, sorted by name
+    std::vector<std::pair<std::string, GLint>> m_uniforms;
+
+    void reflect_uniforms();
 };
 
 }
@@ -0,0 +1,65 @@
+#include "igepch.hpp"
+
+#include "Query.hpp"
+#include "glad/gl.h"
+
+using gl::Query;
+
+Query::Query()
+{
+    glGenQueries(1, &m_id);
+}
+
+Query::Query(Query&& other)
+{
+    *this = std::move(other);
+}
+
+Query& Query::operator=(Query&& other)
+{
+    if (m_id) {
+        glDeleteQueries(1, &m_id);
+    }
+
+    m_id = other.m_id;
+    other.m_id = 0;
+    return *this;
+}
+
+Query::~Query()
+{
+    if (m_id) {
+        glDeleteQueries(1, &m_id);
+    }
+}
+
+GLuint Query::id() const
+{
+    return m_id;
+}
+
+bool Query::available() const
+{
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(m_id, GL_QUERY_RESULT_AVAILABLE, &available);
+
+    return available == GL_TRUE;
+}
+
+GLuint64 Query::result() const
+{
+    GLuint64 result = 0;
+    glGetQueryObjectui64v(m_id, GL_QUERY_RESULT, &result);
+
+    return result;
+}
+
+void Query::begin(Target target, const Query& query)
+{
+    glBeginQuery(static_cast<GLenum>(target), query.id());
+}
+
+void Query::end(Target target)
+{
+    glEndQuery(static_cast<GLenum>(target));
+}
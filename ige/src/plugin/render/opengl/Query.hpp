@@ -0,0 +1,46 @@
+#ifndef A43EBD7C_2B82_4330_9714_B27553F577D9
+#define A43EBD7C_2B82_4330_9714_B27553F577D9
+
+#include "glad/gl.h"
+
+namespace gl {
+
+class Query {
+public:
+    enum class Target : GLenum {
+        SAMPLES_PASSED = GL_SAMPLES_PASSED,
+        ANY_SAMPLES_PASSED = GL_ANY_SAMPLES_PASSED,
+        PRIMITIVES_GENERATED = GL_PRIMITIVES_GENERATED,
+        TIME_ELAPSED = GL_TIME_ELAPSED,
+    };
+
+    Query();
+    Query(const Query&) = delete;
+    Query& operator=(const Query&) = delete;
+    Query(Query&& other);
+    Query& operator=(Query&& other);
+    ~Query();
+
+    GLuint id() const;
+
+    /**
+     * @brief Whether the result of the query can be read without waiting for
+     * the GPU.
+     */
+    bool available() const;
+
+    /**
+     * @brief Result of the query, waits for it to be available.
+     */
+    GLuint64 result() const;
+
+    static void begin(Target, const Query&);
+    static void end(Target);
+
+private:
+    GLuint m_id = 0;
+};
+
+}
+
+#endif /* A43EBD7C_2B82_4330_9714_B27553F577D9 */
@@ -1,23 +1,32 @@
 #include "igepch.hpp"
 
+#include "Error.hpp"
+#include "Framebuffer.hpp"
+#include "Query.hpp"
 #include "SceneRenderer.hpp"
 #include "UiRenderer.hpp"
 #include "glad/gl.h"
 #include "ige/core/App.hpp"
-#include "ige/ecs/Entity.hpp"
 #include "ige/ecs/System.hpp"
 #include "ige/ecs/World.hpp"
 #include "ige/plugin/RenderPlugin.hpp"
-#include "ige/plugin/TransformPlugin.hpp"
+#include "ige/plugin/WindowPlugin.hpp"
+#include "ige/plugin/render/InheritedVisibility.hpp"
+#include "plugin/render/MeshBounds.hpp"
+#include "plugin/render/RenderSnapshot.hpp"
+#include <array>
+#include <cstddef>
 
 using ige::core::App;
-using ige::ecs::EntityId;
 using ige::ecs::System;
 using ige::ecs::World;
+using ige::plugin::render::FrameReadback;
+using ige::plugin::render::GpuFrameTime;
+using ige::plugin::render::InheritedVisibility;
 using ige::plugin::render::RenderPlugin;
 using ige::plugin::render::Visibility;
-using ige::plugin::transform::Children;
-using ige::plugin::transform::Parent;
+using ige::plugin::window::Redraw;
+using ige::plugin::window::WindowInfo;
 
 Visibility::Visibility(bool visible)
     : Visibility(visible, 1.0f)
@@ -51,37 +60,116 @@ void Visibility::force_global_update(bool parent_visible, float parent_opacity)
     m_global_opacity = parent_opacity * opacity;
 }
 
-static void update_visibility_tree(
-    World& world, EntityId entity, Visibility& vis, bool parent_visible = true,
-    float parent_opacity = 1.0f)
+static void propagate_visibility(World& world)
 {
-    vis.force_global_update(parent_visible, parent_opacity);
+    world.get_or_emplace<InheritedVisibility>().update(world);
+}
+
+static void compute_mesh_bounds(World& world)
+{
+    world.get_or_emplace<MeshBounds>().update(world);
+}
 
-    if (auto children = world.get_component<Children>(entity)) {
-        for (auto child : children->entities) {
-            auto& child_vis = world.get_or_emplace_component<Visibility>(child);
+// timer queries of the last frames, each one is read back before being
+// issued again
+struct FrameTimers {
+    static constexpr std::size_t FRAMES = 3;
 
-            update_visibility_tree(
-                world, child, child_vis, vis.global_visible(),
-                vis.global_opacity());
+    std::array<gl::Query, FRAMES> queries;
+    std::array<bool, FRAMES> pending {};
+    std::size_t current = 0;
+    bool running = false;
+};
+
+static bool frame_drawn(World& world)
+{
+    auto redraw = world.get<Redraw>();
+
+    return !redraw || redraw->needed;
+}
+
+static void begin_frame_timer(World& world)
+{
+    auto time = world.get<GpuFrameTime>();
+
+    if (!time || !frame_drawn(world)) {
+        return;
+    }
+
+    auto& timers = world.get_or_emplace<FrameTimers>();
+    const gl::Query& query = timers.queries[timers.current];
+
+    if (timers.pending[timers.current]) {
+        // skip this frame rather than waiting for the GPU
+        if (!query.available()) {
+            return;
         }
+
+        time->milliseconds = double(query.result()) / 1.0e6;
+        time->frames++;
+    }
+
+    gl::Query::begin(gl::Query::Target::TIME_ELAPSED, query);
+    timers.pending[timers.current] = true;
+    timers.running = true;
+}
+
+static void end_frame_timer(World& world)
+{
+    auto timers = world.get<FrameTimers>();
+
+    if (!timers || !timers->running) {
+        return;
     }
+
+    gl::Query::end(gl::Query::Target::TIME_ELAPSED);
+    timers->running = false;
+    timers->current = (timers->current + 1) % FrameTimers::FRAMES;
 }
 
-static void propagate_visibility(World& world)
+static void read_back_frame(World& world)
 {
-    for (auto [entity, rect] : world.query<Visibility>()) {
-        // only update tree roots (entities without a parent).
-        // children will get recursively updated.
-        if (!world.get_component<Parent>(entity)) {
-            update_visibility_tree(world, entity, rect);
-        }
+    auto readback = world.get<FrameReadback>();
+    auto wininfo = world.get<WindowInfo>();
+
+    if (!readback || !wininfo || !frame_drawn(world)) {
+        return;
     }
+
+    readback->width = wininfo->width;
+    readback->height = wininfo->height;
+    readback->pixels.resize(
+        std::size_t(wininfo->width) * std::size_t(wininfo->height) * 4);
+
+    gl::Framebuffer::unbind(gl::Framebuffer::Target::READ_FRAMEBUFFER);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(
+        0, 0, wininfo->width, wininfo->height, GL_RGBA, GL_UNSIGNED_BYTE,
+        readback->pixels.data());
+
+    // `gl::Error::get` only checks in debug builds
+    readback->gl_errors.clear();
+
+    for (GLenum code = glGetError(); code != GL_NO_ERROR;
+         code = glGetError()) {
+        readback->gl_errors.push_back(gl::Error(code).what());
+    }
+}
+
+static void clear_frame_timers(World& world)
+{
+    world.remove<FrameTimers>();
 }
 
 void RenderPlugin::plug(App::Builder& builder) const
 {
     builder.add_system(System::from(propagate_visibility));
+    builder.add_system(System::from(compute_mesh_bounds));
+    builder.add_extract_system(System::from(extract_render_snapshot));
+    builder.add_render_system(System::from(begin_frame_timer));
     builder.add_plugin(SceneRenderer {});
     builder.add_plugin(UiRenderer {});
+    builder.add_render_system(System::from(end_frame_timer));
+    builder.add_render_system(System::from(read_back_frame));
+    builder.add_render_cleanup_system(System::from(clear_frame_timers));
 }
@@ -8,28 +8,37 @@
 #include "Renderbuffer.hpp"
 #include "SceneRenderer.hpp"
 #include "Shader.hpp"
+#include "StateCache.hpp"
 #include "TextureCache.hpp"
+#include "UniformRing.hpp"
 #include "VertexArray.hpp"
 #include "WeakPtrMap.hpp"
 #include "glad/gl.h"
 #include "ige/asset/Material.hpp"
 #include "ige/asset/Mesh.hpp"
-#include "ige/asset/Skeleton.hpp"
 #include "ige/asset/Texture.hpp"
 #include "ige/core/App.hpp"
-#include "ige/ecs/Entity.hpp"
+#include "ige/core/Bounds.hpp"
+#include "ige/core/RadixSort.hpp"
 #include "ige/ecs/World.hpp"
-#include "ige/plugin/AnimationPlugin.hpp"
 #include "ige/plugin/RenderPlugin.hpp"
-#include "ige/plugin/TransformPlugin.hpp"
 #include "ige/plugin/WindowPlugin.hpp"
+#include "ige/plugin/render/LightClusters.hpp"
+#include "plugin/render/RenderSnapshot.hpp"
+#include "res/shaders/gl/depth-fs.glsl.h"
 #include "res/shaders/gl/gbuffer-fs.glsl.h"
 #include "res/shaders/gl/gbuffer-skin-vs.glsl.h"
 #include "res/shaders/gl/gbuffer-vs.glsl.h"
+#include "res/shaders/gl/light-pass-clustered-fs.glsl.h"
 #include "res/shaders/gl/light-pass-fs.glsl.h"
 #include "res/shaders/gl/light-pass-vs.glsl.h"
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 using glm::mat3;
 using glm::mat4;
@@ -38,24 +47,75 @@ using glm::vec3;
 using glm::vec4;
 using ige::asset::Material;
 using ige::asset::Mesh;
-using ige::asset::Skeleton;
 using ige::asset::Texture;
+using ige::core::Aabb;
 using ige::core::App;
-using ige::ecs::EntityId;
+using ige::core::BoundingSphere;
+using ige::core::Frustum;
+using ige::core::RadixSort;
 using ige::ecs::System;
 using ige::ecs::World;
-using ige::plugin::animation::SkeletonPose;
+using ige::plugin::render::CullingStats;
+using ige::plugin::render::DrawStats;
+using ige::plugin::render::GeometryPassOptions;
 using ige::plugin::render::Light;
+using ige::plugin::render::LightClusters;
+using ige::plugin::render::LightPassOptions;
 using ige::plugin::render::LightType;
-using ige::plugin::render::MeshRenderer;
-using ige::plugin::render::PerspectiveCamera;
 using ige::plugin::render::RenderPlugin;
-using ige::plugin::transform::Transform;
+using ige::plugin::window::Redraw;
 using ige::plugin::window::WindowInfo;
 
 using Fbo = gl::Framebuffer;
 
-const std::size_t MAX_JOINTS = 64;
+// per instance attributes of gbuffer-vs.glsl
+struct MeshInstance {
+    mat4 proj_view_model;
+    mat3 normal_matrix;
+};
+
+// first attribute location of `MeshInstance` in gbuffer-vs.glsl
+const GLuint INSTANCE_ATTRIB = 5;
+
+// uniform block binding points, the same for every program
+const GLuint FRAME_BLOCK = 0;
+const GLuint DRAW_BLOCK = 1;
+
+// texture unit of the joint palettes in the skinned programs
+const GLint JOINTS_UNIT = 1;
+
+// std140 layouts of the uniform blocks, see gbuffer-skin-vs.glsl
+struct FrameBlock {
+    mat4 projection;
+    mat4 view;
+    mat4 inv_projection;
+};
+
+struct DrawBlock {
+    mat4 view_model;
+
+    // std140 pads each column of a mat3 to a vec4
+    vec4 normal_matrix[3];
+
+    std::int32_t joint_offset;
+    std::int32_t padding[3];
+};
+
+// uniforms of a gbuffer program, looked up once linked
+struct GbufferUniforms {
+    gl::UniformId base_color_factor;
+    gl::UniformId has_base_color_texture;
+
+    GbufferUniforms() = default;
+
+    explicit GbufferUniforms(gl::Program& program)
+        : base_color_factor(program.uniform_id("u_BaseColorFactor"))
+        , has_base_color_texture(program.uniform_id("u_HasBaseColorTexture"))
+    {
+        // always bound to the first texture unit
+        program.uniform("u_BaseColorTexture", 0);
+    }
+};
 
 class GbufferProgram {
 public:
@@ -78,10 +138,27 @@ public:
             RES_SHADERS_GL_GBUFFER_FS_GLSL,
         };
 
+        gl::Shader depth_fs {
+            gl::Shader::FRAGMENT,
+            RES_SHADERS_GL_DEPTH_FS_GLSL,
+        };
+
         std::cout << "[INFO] Linking GbufferProgram..." << std::endl;
 
         m_static_program.link(gbuffer_vs, gbuffer_fs);
         m_skinned_program.link(gbuffer_skin_vs, gbuffer_fs);
+        m_depth_static_program.link(gbuffer_vs, depth_fs);
+        m_depth_skinned_program.link(gbuffer_skin_vs, depth_fs);
+
+        for (gl::Program* program :
+             { &m_skinned_program, &m_depth_skinned_program }) {
+            program->uniform_block("Frame", FRAME_BLOCK);
+            program->uniform_block("Draw", DRAW_BLOCK);
+            program->uniform("u_Joints", JOINTS_UNIT);
+        }
+
+        m_static_uniforms = GbufferUniforms(m_static_program);
+        m_skinned_uniforms = GbufferUniforms(m_skinned_program);
 
         gl::Error::audit("gbuffer program setup");
     }
@@ -91,9 +168,36 @@ public:
         return skinned ? m_skinned_program : m_static_program;
     }
 
+    // programs of the depth pre-pass, with the same vertex shaders
+    gl::Program& get_depth(bool skinned)
+    {
+        return skinned ? m_depth_skinned_program : m_depth_static_program;
+    }
+
+    const GbufferUniforms& uniforms(bool skinned) const
+    {
+        return skinned ? m_skinned_uniforms : m_static_uniforms;
+    }
+
 private:
     gl::Program m_static_program;
     gl::Program m_skinned_program;
+    gl::Program m_depth_static_program;
+    gl::Program m_depth_skinned_program;
+    GbufferUniforms m_static_uniforms;
+    GbufferUniforms m_skinned_uniforms;
+};
+
+struct ClusteredLightPassUniforms {
+    gl::UniformId global_light_count;
+    gl::UniformId cluster_slices;
+};
+
+struct LightPassUniforms {
+    gl::UniformId light_rect;
+    gl::UniformId light_diffuse;
+    gl::UniformId light_type;
+    gl::UniformId light_position;
 };
 
 class LightPassProgram {
@@ -112,9 +216,42 @@ public:
             RES_SHADERS_GL_LIGHT_PASS_FS_GLSL,
         };
 
+        gl::Shader light_pass_clustered_fs {
+            gl::Shader::FRAGMENT,
+            RES_SHADERS_GL_LIGHT_PASS_CLUSTERED_FS_GLSL,
+        };
+
         std::cout << "[INFO] Linking LightPassProgram..." << std::endl;
 
         m_main_program.link(light_pass_vs, light_pass_fs);
+        m_clustered_program.link(light_pass_vs, light_pass_clustered_fs);
+
+        for (gl::Program* program : { &m_main_program, &m_clustered_program }) {
+            // the gbuffer is always bound to the same texture units
+            program->uniform("u_GbufferAlbedo", 0);
+            program->uniform("u_GbufferNormal", 1);
+            program->uniform("u_GbufferDepth", 2);
+
+            program->uniform_block("Frame", FRAME_BLOCK);
+        }
+
+        // the clustered pass always covers the whole screen
+        m_clustered_program.uniform(
+            "u_LightRect", vec4(-1.0f, -1.0f, 1.0f, 1.0f));
+        m_clustered_program.uniform("u_Lights", 3);
+        m_clustered_program.uniform("u_Clusters", 4);
+        m_clustered_program.uniform("u_LightIndices", 5);
+
+        m_clustered_uniforms.global_light_count
+            = m_clustered_program.uniform_id("u_GlobalLightCount");
+        m_clustered_uniforms.cluster_slices
+            = m_clustered_program.uniform_id("u_ClusterSlices");
+
+        m_uniforms.light_rect = m_main_program.uniform_id("u_LightRect");
+        m_uniforms.light_diffuse = m_main_program.uniform_id("u_LightDiffuse");
+        m_uniforms.light_type = m_main_program.uniform_id("u_LightType");
+        m_uniforms.light_position
+            = m_main_program.uniform_id("u_LightPosition");
 
         gl::Error::audit("light pass program setup");
     }
@@ -124,8 +261,26 @@ public:
         return m_main_program;
     }
 
+    const LightPassUniforms& uniforms() const
+    {
+        return m_uniforms;
+    }
+
+    gl::Program& get_clustered()
+    {
+        return m_clustered_program;
+    }
+
+    const ClusteredLightPassUniforms& clustered_uniforms() const
+    {
+        return m_clustered_uniforms;
+    }
+
 private:
     gl::Program m_main_program;
+    gl::Program m_clustered_program;
+    LightPassUniforms m_uniforms;
+    ClusteredLightPassUniforms m_clustered_uniforms;
 };
 
 class RenderCache {
@@ -139,6 +294,45 @@ public:
 
     gl::VertexArray quad_vao;
 
+    // frustum culling buffers, reused every frame
+    std::vector<Aabb> mesh_bounds;
+    std::vector<std::uint8_t> mesh_in_frustum;
+    std::vector<std::size_t> visible_meshes;
+
+    // draw list, reused every frame
+    std::vector<std::uint64_t> draw_keys;
+    std::vector<std::uint32_t> draw_order;
+    std::vector<std::uint32_t> draw_group_ends;
+    std::unordered_map<const Material*, std::size_t> material_ids;
+    RadixSort draw_sort;
+    gl::StateCache state;
+
+    // instancing buffers, reused every frame
+    std::vector<MeshInstance> instances;
+    gl::Buffer instance_buffer;
+
+    // uniform blocks, written every frame
+    gl::UniformRing uniform_ring;
+    std::size_t frame_block = 0;
+
+    // offset of the draw block of each skinned mesh
+    std::vector<std::size_t> skinned_blocks;
+
+    // joint palettes of the frame, read from a texture buffer
+    gl::Buffer joint_buffer;
+    gl::Texture joint_texture;
+
+    // clustered light pass, lights are read from texture buffers
+    LightClusters light_clusters;
+    std::vector<vec4> light_data;
+    std::vector<BoundingSphere> light_volumes;
+    gl::Buffer light_buffer;
+    gl::Buffer cluster_buffer;
+    gl::Buffer light_index_buffer;
+    gl::Texture light_texture;
+    gl::Texture cluster_texture;
+    gl::Texture light_index_texture;
+
     RenderCache(std::uint32_t width, std::uint32_t height) noexcept
     {
         vec2 quad[4] = {
@@ -177,6 +371,38 @@ public:
         gl::Renderbuffer::unbind();
 
         m_valid &= !gl::Error::audit("gbuffer fbo creation");
+
+        // texture buffers keep pointing to their buffer when it is resized
+        const auto TEXTURE_BUFFER = gl::Texture::Target::TEXTURE_BUFFER;
+        const auto BUFFER_TARGET = gl::Buffer::Target::TEXTURE_BUFFER;
+
+        // a buffer name only becomes a buffer object once it is bound, and
+        // can't back a texture before that
+        gl::Buffer::bind(BUFFER_TARGET, light_buffer);
+        gl::Buffer::bind(BUFFER_TARGET, cluster_buffer);
+        gl::Buffer::bind(BUFFER_TARGET, light_index_buffer);
+        gl::Buffer::bind(BUFFER_TARGET, joint_buffer);
+        gl::Buffer::unbind(BUFFER_TARGET);
+
+        gl::Texture::bind(TEXTURE_BUFFER, light_texture);
+        gl::Texture::buffer(
+            TEXTURE_BUFFER, gl::Texture::InternalFormat::RGBA32F,
+            light_buffer);
+        gl::Texture::bind(TEXTURE_BUFFER, cluster_texture);
+        gl::Texture::buffer(
+            TEXTURE_BUFFER, gl::Texture::InternalFormat::RG32UI,
+            cluster_buffer);
+        gl::Texture::bind(TEXTURE_BUFFER, light_index_texture);
+        gl::Texture::buffer(
+            TEXTURE_BUFFER, gl::Texture::InternalFormat::R32UI,
+            light_index_buffer);
+        gl::Texture::bind(TEXTURE_BUFFER, joint_texture);
+        gl::Texture::buffer(
+            TEXTURE_BUFFER, gl::Texture::InternalFormat::RGBA32F,
+            joint_buffer);
+        gl::Texture::unbind(TEXTURE_BUFFER);
+
+        m_valid &= !gl::Error::audit("light buffers creation");
     }
 
     void update_size(std::uint32_t width, std::uint32_t height)
@@ -226,7 +452,7 @@ public:
         return m_valid;
     }
 
-    const MeshCache& get(std::shared_ptr<Mesh> mesh)
+    MeshCache& get(std::shared_ptr<Mesh> mesh)
     {
         auto iter = m_meshes.find(mesh);
 
@@ -259,113 +485,535 @@ private:
     std::uint32_t m_height = 0;
 };
 
-static void draw_mesh(
-    World& world, RenderCache& cache, const MeshRenderer& renderer,
-    const mat4& projection, const mat4& view, const Transform& xform)
+// sort keys of mesh draws, from the most to the least expensive state change
+const unsigned PROGRAM_SHIFT = 63;
+const unsigned CULLING_SHIFT = 62;
+const unsigned TEXTURE_SHIFT = 48;
+const unsigned MATERIAL_SHIFT = 32;
+const unsigned VERTEX_ARRAY_SHIFT = 16;
+const unsigned DEPTH_BITS = 16;
+
+static std::uint64_t draw_key(
+    RenderCache& cache, const RenderSnapshot::MeshDraw& draw, bool skinned,
+    float depth)
+{
+    auto [material, inserted] = cache.material_ids.try_emplace(
+        draw.material.get(), cache.material_ids.size());
+
+    GLuint texture = draw.base_color_texture
+        ? cache.get(draw.base_color_texture).gl_texture.id()
+        : 0;
+    GLuint vertex_array = cache.get(draw.mesh).vertex_array().id();
+
+    // front to back
+    auto quantized_depth = static_cast<std::uint64_t>(
+        glm::clamp(depth, 0.0f, 1.0f) * float((1 << DEPTH_BITS) - 1));
+
+    // the fields may overflow: this only makes sorting less efficient, draws
+    // are only grouped if they really use the same mesh and material
+    return std::uint64_t(skinned) << PROGRAM_SHIFT
+        | std::uint64_t(draw.double_sided) << CULLING_SHIFT
+        | (std::uint64_t(texture) & 0x3FFF) << TEXTURE_SHIFT
+        | (std::uint64_t(material->second) & 0xFFFF) << MATERIAL_SHIFT
+        | (std::uint64_t(vertex_array) & 0xFFFF) << VERTEX_ARRAY_SHIFT
+        | quantized_depth;
+}
+
+static void use_material(
+    RenderCache& cache, bool skinned, const RenderSnapshot::MeshDraw& draw)
+{
+    gl::Program& program = cache.gbuffer_program->get(skinned);
+    const auto& uniforms = cache.gbuffer_program->uniforms(skinned);
+
+    program.uniform(uniforms.base_color_factor, draw.base_color_factor);
+
+    if (draw.base_color_texture) {
+        cache.state.bind_texture_2d(
+            0, cache.get(draw.base_color_texture).gl_texture);
+        program.uniform(uniforms.has_base_color_texture, true);
+    } else {
+        program.uniform(uniforms.has_base_color_texture, false);
+    }
+}
+
+// draw the mesh with the current program and vertex array
+static void
+draw_elements(const RenderSnapshot::MeshDraw& draw, std::size_t instances = 1)
+{
+    GLenum topology = GL_TRIANGLES;
+
+    switch (draw.mesh->topology()) {
+    case Mesh::Topology::TRIANGLES:
+        topology = GL_TRIANGLES;
+        break;
+    case Mesh::Topology::TRIANGLE_STRIP:
+        topology = GL_TRIANGLE_STRIP;
+        break;
+    }
+
+    const auto count = static_cast<GLsizei>(draw.mesh->index_buffer().size());
+
+    if (instances == 1) {
+        glDrawElements(topology, count, GL_UNSIGNED_INT, 0);
+    } else {
+        glDrawElementsInstanced(
+            topology, count, GL_UNSIGNED_INT, 0,
+            static_cast<GLsizei>(instances));
+    }
+
+    gl::Error::audit("draw elements");
+}
+
+// stage the draw block of a skinned mesh in the uniform ring
+static std::size_t push_skinned_block(
+    RenderCache& cache, const RenderSnapshot::MeshDraw& draw, const mat4& view)
+{
+    const mat4 view_model = view * draw.model;
+    const mat3 normal_matrix = glm::transpose(glm::inverse(mat3(view_model)));
+
+    DrawBlock block {
+        view_model,
+        { vec4(normal_matrix[0], 0.0f), vec4(normal_matrix[1], 0.0f),
+          vec4(normal_matrix[2], 0.0f) },
+        static_cast<std::int32_t>(draw.joint_offset),
+        {},
+    };
+
+    return cache.uniform_ring.push(block);
+}
+
+// skinned meshes have their own draw block, they are drawn one by one with a
+// skinned program in use
+static void draw_skinned_mesh(
+    RenderCache& cache, const RenderSnapshot::MeshDraw& draw,
+    std::size_t block)
+{
+    const MeshCache& mesh = cache.get(draw.mesh);
+
+    cache.uniform_ring.bind(DRAW_BLOCK, block, sizeof(DrawBlock));
+    cache.state.bind(mesh.vertex_array());
+    draw_elements(draw);
+}
+
+// upload the joint palettes of every skeleton at once
+static void upload_joints(RenderCache& cache, const RenderSnapshot& snapshot)
+{
+    if (snapshot.joint_matrices.empty()) {
+        return;
+    }
+
+    const auto TEXTURE_BUFFER = gl::Buffer::Target::TEXTURE_BUFFER;
+
+    gl::Buffer::bind(TEXTURE_BUFFER, cache.joint_buffer);
+    gl::Buffer::data(
+        TEXTURE_BUFFER, std::span<const mat4>(snapshot.joint_matrices),
+        gl::Buffer::Usage::STREAM_DRAW);
+    gl::Buffer::unbind(TEXTURE_BUFFER);
+
+    glActiveTexture(GL_TEXTURE0 + JOINTS_UNIT);
+    gl::Texture::bind(
+        gl::Texture::Target::TEXTURE_BUFFER, cache.joint_texture);
+    glActiveTexture(GL_TEXTURE0);
+
+    gl::Error::audit("joint palettes upload");
+}
+
+// read the instance attributes of `vao` from `cache.instances[first]` onwards
+static void
+bind_instances(RenderCache& cache, gl::VertexArray& vao, std::size_t first)
+{
+    const auto FLOAT = gl::VertexArray::Type::FLOAT;
+    const GLsizei stride = sizeof(MeshInstance);
+    const std::size_t base = first * sizeof(MeshInstance);
+
+    // `attrib` binds the vertex array, keep the state cache in sync
+    cache.state.bind(vao);
+
+    for (GLuint col = 0; col < 4; col++) {
+        const std::size_t offset = base
+            + offsetof(MeshInstance, proj_view_model) + col * sizeof(vec4);
+
+        vao.attrib(
+            INSTANCE_ATTRIB + col, 4, FLOAT, cache.instance_buffer, stride,
+            static_cast<GLsizei>(offset));
+        vao.divisor(INSTANCE_ATTRIB + col, 1);
+    }
+
+    for (GLuint col = 0; col < 3; col++) {
+        const std::size_t offset = base + offsetof(MeshInstance, normal_matrix)
+            + col * sizeof(vec3);
+
+        vao.attrib(
+            INSTANCE_ATTRIB + 4 + col, 3, FLOAT, cache.instance_buffer, stride,
+            static_cast<GLsizei>(offset));
+        vao.divisor(INSTANCE_ATTRIB + 4 + col, 1);
+    }
+}
+
+// sort the visible meshes, group them, and upload their instances and uniform
+// blocks for `draw_meshes`
+static void prepare_draws(
+    RenderCache& cache, const RenderSnapshot& snapshot, const mat4& projection,
+    const mat4& view, bool front_to_back)
 {
-    const mat4 view_model = view * xform.local_to_world();
-    const mat4 pvm = projection * view_model;
+    const auto& camera = snapshot.camera->params;
+    auto& keys = cache.draw_keys;
+    auto& order = cache.draw_order;
+
+    keys.clear();
+    order.clear();
+    cache.material_ids.clear();
+
+    for (std::size_t i : cache.visible_meshes) {
+        const auto& draw = snapshot.meshes[i];
+        bool skinned = cache.get(draw.mesh).has_skin();
+
+        float z = -(view * draw.model[3]).z;
+        float depth = (z - camera.near) / (camera.far - camera.near);
+        std::uint64_t key = draw_key(cache, draw, skinned, depth);
+
+        // depth first, the state only breaks ties
+        if (front_to_back) {
+            key = std::rotr(key, DEPTH_BITS);
+        }
 
-    mat3 normal_matrix = glm::transpose(glm::inverse(mat3(view_model)));
-    bool double_sided = false;
+        keys.push_back(key);
+        order.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    cache.draw_sort.sort(keys, order);
+
+    // every field of the key but the depth
+    auto state = [&](std::size_t i) {
+        return front_to_back ? keys[i] & (~std::uint64_t(0) >> DEPTH_BITS)
+                             : keys[i] >> DEPTH_BITS;
+    };
+
+    auto skinned = [&](std::size_t i) {
+        return state(i) >> (PROGRAM_SHIFT - DEPTH_BITS) != 0;
+    };
 
-    const MeshCache& mesh = cache.get(renderer.mesh);
+    // draws are grouped if they only differ by depth
+    auto same_group = [&](std::size_t a, std::size_t b) {
+        const auto& draw_a = snapshot.meshes[order[a]];
+        const auto& draw_b = snapshot.meshes[order[b]];
+
+        return state(a) == state(b) && !skinned(a) && draw_a.mesh == draw_b.mesh
+            && draw_a.material == draw_b.material;
+    };
+
+    cache.draw_group_ends.clear();
+
+    for (std::size_t i = 1; i <= order.size(); i++) {
+        if (i == order.size() || !same_group(i - 1, i)) {
+            cache.draw_group_ends.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
 
-    gl::Program& program = cache.gbuffer_program->get(mesh.has_skin());
+    cache.instances.clear();
+    cache.skinned_blocks.clear();
 
-    program.use();
-    program.uniform("u_ProjViewModel", pvm);
-    program.uniform("u_NormalMatrix", normal_matrix);
+    for (std::size_t i = 0; i < order.size(); i++) {
+        const auto& draw = snapshot.meshes[order[i]];
 
-    if (mesh.has_skin() && renderer.skeleton_pose) {
-        auto pose = world.get_component<SkeletonPose>(*renderer.skeleton_pose);
+        if (!skinned(i)) {
+            const mat4 view_model = view * draw.model;
 
-        if (!pose) {
-            std::cerr << "[WARN] Missing SkeletonPose" << std::endl;
+            cache.instances.push_back({
+                projection * view_model,
+                glm::transpose(glm::inverse(mat3(view_model))),
+            });
         } else {
-            const auto& skeleton = *pose->skeleton;
-            std::size_t joint_count = skeleton.joints.size();
-            joint_count = std::min(MAX_JOINTS, joint_count);
-            mat4 joint_matrices[64];
-
-            // compute joint matrices:
-            // jointMatrix[j] =
-            //        inverse(globalTransform)
-            //      * globalJointTransform[j]
-            //      * inverseBindMatrix[j];
-
-            // const mat4 inv_model = xform.world_to_local();
-
-            for (std::size_t j = 0; j < joint_count; j++) {
-                // TODO: figure out why this is a lie
-                // joint_matrices[j] = inv_model;
-                joint_matrices[j] = pose->global_pose[j];
-                joint_matrices[j] *= skeleton.joints[j].inv_bind_matrix;
-            }
+            cache.skinned_blocks.push_back(
+                push_skinned_block(cache, draw, view));
+        }
+    }
+
+    if (!cache.instances.empty()) {
+        gl::Buffer::bind(
+            gl::Buffer::Target::ARRAY_BUFFER, cache.instance_buffer);
+        gl::Buffer::data(
+            gl::Buffer::Target::ARRAY_BUFFER,
+            std::span<const MeshInstance>(cache.instances),
+            gl::Buffer::Usage::STREAM_DRAW);
+
+        gl::Error::audit("instance buffer upload");
+    }
+
+    cache.uniform_ring.upload();
+    cache.uniform_ring.bind(FRAME_BLOCK, cache.frame_block, sizeof(FrameBlock));
 
-            program.uniform(
-                "u_JointMatrix",
-                std::span {
-                    &joint_matrices[0],
-                    &joint_matrices[joint_count],
-                });
+    gl::Error::audit("uniform ring upload");
+}
+
+// draw the groups made by `prepare_draws`, with a single instanced draw call
+// for each group of static meshes sharing the same mesh and material
+//
+// a depth only pass skips materials, using programs that only write depth
+static void
+draw_meshes(RenderCache& cache, const RenderSnapshot& snapshot, bool depth_only)
+{
+    std::span<const std::uint32_t> order = cache.draw_order;
+    std::size_t first = 0;
+    std::size_t first_instance = 0;
+    std::size_t next_skinned = 0;
+    const gl::Program* last_program = nullptr;
+    const Material* last_material = nullptr;
+
+    for (std::uint32_t end : cache.draw_group_ends) {
+        auto group = order.subspan(first, end - first);
+        first = end;
+
+        const auto& draw = snapshot.meshes[group[0]];
+        MeshCache& mesh = cache.get(draw.mesh);
+        gl::Program& program = depth_only
+            ? cache.gbuffer_program->get_depth(mesh.has_skin())
+            : cache.gbuffer_program->get(mesh.has_skin());
+
+        cache.state.use(program);
+        cache.state.enable(GL_CULL_FACE, !draw.double_sided);
+
+        // programs keep their uniforms
+        if (!depth_only
+            && (&program != last_program
+                || draw.material.get() != last_material)) {
+            use_material(cache, mesh.has_skin(), draw);
+
+            last_program = &program;
+            last_material = draw.material.get();
+        }
+
+        // skinned meshes are never grouped
+        if (mesh.has_skin()) {
+            draw_skinned_mesh(
+                cache, draw, cache.skinned_blocks[next_skinned++]);
+            continue;
+        }
+
+        bind_instances(cache, mesh.vertex_array(), first_instance);
+        draw_elements(draw, group.size());
+
+        first_instance += group.size();
+    }
+}
+
+// fill `cache.visible_meshes` with the indices of the meshes to draw
+static CullingStats cull_meshes(
+    RenderCache& cache, const RenderSnapshot& snapshot, const Frustum& frustum)
+{
+    cache.mesh_bounds.clear();
+
+    for (const auto& draw : snapshot.meshes) {
+        if (draw.bounds) {
+            cache.mesh_bounds.push_back(*draw.bounds);
+        }
+    }
+
+    cache.mesh_in_frustum.resize(cache.mesh_bounds.size());
+    frustum.cull(cache.mesh_bounds, cache.mesh_in_frustum);
+
+    cache.visible_meshes.clear();
+    std::size_t box = 0;
+
+    for (std::size_t i = 0; i < snapshot.meshes.size(); i++) {
+        if (!snapshot.meshes[i].bounds || cache.mesh_in_frustum[box++]) {
+            cache.visible_meshes.push_back(i);
         }
     }
 
-    if (renderer.material) {
-        double_sided = renderer.material->double_sided();
+    std::size_t visible = cache.visible_meshes.size();
+
+    return { visible, snapshot.meshes.size() - visible };
+}
+
+// restrict drawing to the pixels covered by `rect`, in NDC
+static void
+scissor(const vec4& rect, std::uint32_t width, std::uint32_t height)
+{
+    const vec2 size { float(width), float(height) };
+    const vec4 pixels = (rect * 0.5f + 0.5f) * vec4(size, size);
+
+    const auto x = static_cast<GLint>(glm::floor(pixels.x));
+    const auto y = static_cast<GLint>(glm::floor(pixels.y));
+
+    glScissor(
+        x, y, static_cast<GLsizei>(glm::ceil(pixels.z)) - x,
+        static_cast<GLsizei>(glm::ceil(pixels.w)) - y);
+}
+
+static vec3 light_diffuse(const Light& light)
+{
+    vec3 color = glm::clamp(light.color, vec3(0.0f), vec3(1.0f));
+
+    return color * light.intensity;
+}
+
+// direction of a directional light, in view space
+static vec3 light_direction(const mat4& view_model)
+{
+    vec3 dir(0.0f, -1.0f, 0.0f);
+
+    return glm::normalize(mat3(view_model) * dir);
+}
+
+// draw a quad for each light, covering the part of the screen it reaches
+static void draw_lights(
+    RenderCache& cache, const RenderSnapshot& snapshot, const mat4& projection,
+    const mat4& view, bool use_scissor, std::uint32_t width,
+    std::uint32_t height)
+{
+    gl::Program& program = cache.light_pass_program->get();
+    const auto& uniforms = cache.light_pass_program->uniforms();
+
+    cache.state.use(program);
+
+    // point lights outside of this (view space) frustum are skipped
+    const Frustum view_frustum = Frustum::from_matrix(projection);
+    const vec4 full_screen(-1.0f, -1.0f, 1.0f, 1.0f);
+
+    if (use_scissor) {
+        program.uniform(uniforms.light_rect, full_screen);
+        glEnable(GL_SCISSOR_TEST);
+    }
+
+    for (const auto& [light, model] : snapshot.lights) {
+        vec4 rect = full_screen;
+
+        switch (light.type) {
+        case LightType::AMBIENT:
+            program.uniform(uniforms.light_type, 0);
+            break;
+        case LightType::POINT: {
+            vec3 pos = view * model * vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            BoundingSphere volume { pos, light.range };
+
+            if (!view_frustum.intersects(volume)) {
+                continue;
+            }
+
+            rect = volume.screen_rect(projection);
+
+            program.uniform(uniforms.light_type, 1);
+            program.uniform(uniforms.light_position, vec4(pos, light.range));
+        } break;
+        case LightType::DIRECTIONAL: {
+            vec3 dir = light_direction(view * model);
+
+            program.uniform(uniforms.light_type, 2);
+            program.uniform(uniforms.light_position, vec4(dir, 0.0f));
+        } break;
+        }
 
-        program.uniform(
-            "u_BaseColorFactor",
-            renderer.material->get_or("base_color_factor", vec4(1.0f)));
+        program.uniform(uniforms.light_diffuse, light_diffuse(light));
 
-        auto base_texture = renderer.material->get("base_color_texture");
-        if (base_texture
-            && base_texture->type == Material::ParameterType::TEXTURE) {
-            glActiveTexture(GL_TEXTURE0);
-            gl::Texture::bind(
-                gl::Texture::Target::TEXTURE_2D,
-                cache.get(base_texture->texture).gl_texture);
-            program.uniform("u_BaseColorTexture", 0);
-            program.uniform("u_HasBaseColorTexture", true);
+        if (use_scissor) {
+            scissor(rect, width, height);
         } else {
-            program.uniform("u_HasBaseColorTexture", false);
+            program.uniform(uniforms.light_rect, rect);
         }
+
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     }
 
-    mesh.vertex_array().bind();
-    GLenum topology = GL_TRIANGLES;
+    glDisable(GL_SCISSOR_TEST);
+}
 
-    switch (renderer.mesh->topology()) {
-    case Mesh::Topology::TRIANGLES:
-        topology = GL_TRIANGLES;
-        break;
-    case Mesh::Topology::TRIANGLE_STRIP:
-        topology = GL_TRIANGLE_STRIP;
-        break;
+// upload all the lights at once, and shade each pixel with the lights of its
+// cluster in a single full screen pass
+static void draw_clustered_lights(
+    RenderCache& cache, const RenderSnapshot& snapshot, float aspect,
+    const mat4& view)
+{
+    const auto& camera = snapshot.camera->params;
+    auto& data = cache.light_data;
+
+    data.clear();
+    cache.light_volumes.clear();
+
+    // ambient and directional lights first, they aren't clustered
+    for (const auto& [light, model] : snapshot.lights) {
+        switch (light.type) {
+        case LightType::AMBIENT:
+            data.push_back(vec4(0.0f));
+            data.push_back(vec4(light_diffuse(light), 0.0f));
+            break;
+        case LightType::DIRECTIONAL:
+            data.push_back(vec4(light_direction(view * model), 0.0f));
+            data.push_back(vec4(light_diffuse(light), 2.0f));
+            break;
+        case LightType::POINT:
+            break;
+        }
     }
 
-    if (double_sided) {
-        glDisable(GL_CULL_FACE);
-    } else {
-        glEnable(GL_CULL_FACE);
+    const auto global_lights = static_cast<GLint>(data.size() / 2);
+
+    for (const auto& [light, model] : snapshot.lights) {
+        if (light.type == LightType::POINT) {
+            vec3 pos = view * model * vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+            data.push_back(vec4(pos, light.range));
+            data.push_back(vec4(light_diffuse(light), 1.0f));
+            cache.light_volumes.push_back({ pos, light.range });
+        }
     }
-    glDrawElements(
-        topology, static_cast<GLsizei>(renderer.mesh->index_buffer().size()),
-        GL_UNSIGNED_INT, 0);
 
-    gl::Error::audit("draw elements");
+    cache.light_clusters.set_projection(
+        glm::radians(camera.fov), aspect, camera.near, camera.far);
+    cache.light_clusters.assign(cache.light_volumes);
+
+    const auto TEXTURE_BUFFER = gl::Buffer::Target::TEXTURE_BUFFER;
+    const auto STREAM_DRAW = gl::Buffer::Usage::STREAM_DRAW;
+
+    gl::Buffer::bind(TEXTURE_BUFFER, cache.light_buffer);
+    gl::Buffer::data(TEXTURE_BUFFER, std::span<const vec4>(data), STREAM_DRAW);
+    gl::Buffer::bind(TEXTURE_BUFFER, cache.cluster_buffer);
+    gl::Buffer::data(
+        TEXTURE_BUFFER, cache.light_clusters.clusters(), STREAM_DRAW);
+    gl::Buffer::bind(TEXTURE_BUFFER, cache.light_index_buffer);
+    gl::Buffer::data(
+        TEXTURE_BUFFER, cache.light_clusters.indices(), STREAM_DRAW);
+    gl::Buffer::unbind(TEXTURE_BUFFER);
+
+    gl::Error::audit("light clusters upload");
+
+    gl::Program& program = cache.light_pass_program->get_clustered();
+    const auto& uniforms = cache.light_pass_program->clustered_uniforms();
+
+    cache.state.use(program);
+    program.uniform(uniforms.global_light_count, global_lights);
+    program.uniform(
+        uniforms.cluster_slices,
+        vec2(cache.light_clusters.near(), cache.light_clusters.slice_scale()));
+
+    glActiveTexture(GL_TEXTURE3);
+    gl::Texture::bind(
+        gl::Texture::Target::TEXTURE_BUFFER, cache.light_texture);
+    glActiveTexture(GL_TEXTURE4);
+    gl::Texture::bind(
+        gl::Texture::Target::TEXTURE_BUFFER, cache.cluster_texture);
+    glActiveTexture(GL_TEXTURE5);
+    gl::Texture::bind(
+        gl::Texture::Target::TEXTURE_BUFFER, cache.light_index_texture);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 }
 
 namespace systems {
 
 static void render_meshes(World& world)
 {
-    // TODO: gracefully handle the case where no WindowInfo is present
+    auto redraw = world.get<Redraw>();
+
+    if (redraw && !redraw->needed) {
+        return;
+    }
+
     auto wininfo = world.get<WindowInfo>();
-    auto cameras = world.query<PerspectiveCamera, Transform>();
+    auto snapshot = world.get<RenderSnapshot>();
 
-    if (cameras.empty() || wininfo->width == 0 || wininfo->height == 0) {
+    if (!wininfo || !snapshot || !snapshot->camera || wininfo->width == 0
+        || wininfo->height == 0) {
         return;
     }
 
@@ -380,14 +1028,14 @@ static void render_meshes(World& world)
 
     gl::Error::audit("render cache setup");
 
-    auto& [camera_entity, camera, camera_xform] = cameras[0];
+    const auto& camera = snapshot->camera->params;
 
     const mat4 projection = glm::perspective(
         glm::radians(camera.fov),
         float(wininfo->width) / float(wininfo->height), camera.near,
         camera.far);
     const mat4 inv_proj = glm::inverse(projection);
-    const mat4 view = camera_xform.world_to_local();
+    const mat4 view = snapshot->camera->view;
 
     // gbuffer pass:
     Fbo::bind(Fbo::Target::FRAMEBUFFER, cache.gbuffer);
@@ -403,11 +1051,47 @@ static void render_meshes(World& world)
 
     gl::Error::audit("gbuffer pipeline setup");
 
-    auto meshes = world.query<MeshRenderer, Transform>();
-    for (auto& [entity, renderer, xform] : meshes) {
-        draw_mesh(world, cache, renderer, projection, view, xform);
+    upload_joints(cache, *snapshot);
+
+    // other passes and renderers don't go through the state cache
+    cache.state.reset();
+    cache.state.clear_stats();
+
+    cache.frame_block = cache.uniform_ring.push(
+        FrameBlock { projection, view, inv_proj });
+
+    world.get_or_emplace<CullingStats>() = cull_meshes(
+        cache, *snapshot, Frustum::from_matrix(projection * view));
+
+    const auto options = world.get<GeometryPassOptions>();
+    const bool depth_prepass = options && options->depth_prepass;
+
+    prepare_draws(
+        cache, *snapshot, projection, view, options && options->front_to_back);
+
+    if (depth_prepass) {
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        draw_meshes(cache, *snapshot, true);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        // only the closest fragments are left to shade
+        glDepthMask(GL_FALSE);
+        glDepthFunc(GL_LEQUAL);
     }
 
+    draw_meshes(cache, *snapshot, false);
+
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+
+    const std::size_t passes = depth_prepass ? 2 : 1;
+
+    world.get_or_emplace<DrawStats>() = {
+        cache.draw_group_ends.size() * passes,
+        cache.state.stats().changes,
+        cache.state.stats().avoided,
+    };
+
     // light pass:
     Fbo::unbind(Fbo::Target::FRAMEBUFFER);
 
@@ -419,69 +1103,37 @@ static void render_meshes(World& world)
 
     cache.quad_vao.bind();
 
-    gl::Program& program = cache.light_pass_program->get();
-
-    program.use();
-
-    program.uniform("u_InvProjection", inv_proj);
-
     // bind albedo texture
     glActiveTexture(GL_TEXTURE0);
     gl::Texture::bind(gl::Texture::Target::TEXTURE_2D, cache.gbuffer_albedo);
-    program.uniform("u_GbufferAlbedo", 0);
 
     // bind normal texture
     glActiveTexture(GL_TEXTURE1);
     gl::Texture::bind(gl::Texture::Target::TEXTURE_2D, cache.gbuffer_normal);
-    program.uniform("u_GbufferNormal", 1);
 
     // bind normal texture
     glActiveTexture(GL_TEXTURE2);
     gl::Texture::bind(
         gl::Texture::Target::TEXTURE_2D, cache.gbuffer_depth_stencil);
-    program.uniform("u_GbufferDepth", 2);
-
-    for (auto [entity, light] : world.query<Light>()) {
-        vec3 color = glm::clamp(light.color, vec3(0.0f), vec3(1.0f));
-
-        program.uniform("u_LightDiffuse", color * light.intensity);
-
-        switch (light.type) {
-        case LightType::AMBIENT:
-            program.uniform("u_LightType", 0);
-            break;
-        case LightType::POINT: {
-            vec3 pos(0.0f);
-
-            if (auto xform = world.get_component<Transform>(entity)) {
-                pos = xform->local_to_world() * vec4(pos, 1.0f);
-            }
-
-            pos = view * vec4(pos, 1.0f);
-
-            program.uniform("u_LightType", 1);
-            program.uniform("u_LightPosition", vec4(pos, light.range));
-        } break;
-        case LightType::DIRECTIONAL: {
-            vec3 dir(0.0f, -1.0f, 0.0f);
-
-            if (auto xform = world.get_component<Transform>(entity)) {
-                dir = mat3(view * xform->local_to_world()) * dir;
-            } else {
-                dir = mat3(view) * dir;
-            }
 
-            dir = glm::normalize(dir);
+    const auto light_options = world.get<LightPassOptions>();
 
-            program.uniform("u_LightType", 2);
-            program.uniform("u_LightPosition", vec4(dir, 0.0f));
-        } break;
-        }
+    if (light_options && light_options->clustered) {
+        draw_clustered_lights(
+            cache, *snapshot,
+            float(wininfo->width) / float(wininfo->height), view);
+    } else {
+        const bool use_scissor = light_options
+            && light_options->bounds == LightPassOptions::Bounds::SCISSOR;
 
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        draw_lights(
+            cache, *snapshot, projection, view, use_scissor, wininfo->width,
+            wininfo->height);
     }
 
     gl::Error::audit("light pass");
+
+    cache.uniform_ring.end_frame();
 }
 
 static void clear_cache(World& world)
@@ -493,6 +1145,6 @@ static void clear_cache(World& world)
 
 void SceneRenderer::plug(App::Builder& builder) const
 {
-    builder.add_system(System::from(systems::render_meshes));
-    builder.add_cleanup_system(System::from(systems::clear_cache));
+    builder.add_render_system(System::from(systems::render_meshes));
+    builder.add_render_cleanup_system(System::from(systems::clear_cache));
 }
@@ -0,0 +1,98 @@
+#include "igepch.hpp"
+
+#include "Program.hpp"
+#include "StateCache.hpp"
+#include "Texture.hpp"
+#include "VertexArray.hpp"
+#include "glad/gl.h"
+#include <algorithm>
+#include <optional>
+
+using gl::Program;
+using gl::StateCache;
+using gl::Texture;
+using gl::VertexArray;
+
+void StateCache::reset()
+{
+    m_capabilities.clear();
+    m_program.reset();
+    m_vertex_array.reset();
+    m_active_texture.reset();
+    m_textures.fill(std::nullopt);
+}
+
+void StateCache::enable(GLenum capability, bool enabled)
+{
+    auto it = std::find_if(
+        m_capabilities.begin(), m_capabilities.end(),
+        [&](const auto& cap) { return cap.name == capability; });
+
+    if (it == m_capabilities.end()) {
+        m_capabilities.push_back({ capability, enabled });
+    } else if (it->enabled == enabled) {
+        m_stats.avoided++;
+        return;
+    } else {
+        it->enabled = enabled;
+    }
+
+    m_stats.changes++;
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void StateCache::use(const Program& program)
+{
+    if (change(m_program, program.id())) {
+        program.use();
+    }
+}
+
+void StateCache::bind(const VertexArray& vertex_array)
+{
+    if (change(m_vertex_array, vertex_array.id())) {
+        vertex_array.bind();
+    }
+}
+
+void StateCache::bind_texture_2d(GLuint unit, const Texture& texture)
+{
+    if (m_textures[unit] == texture.id()) {
+        m_stats.avoided++;
+        return;
+    }
+
+    if (change(m_active_texture, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+
+    change(m_textures[unit], texture.id());
+    Texture::bind(Texture::Target::TEXTURE_2D, texture);
+}
+
+const StateCache::Stats& StateCache::stats() const
+{
+    return m_stats;
+}
+
+void StateCache::clear_stats()
+{
+    m_stats = {};
+}
+
+bool StateCache::change(std::optional<GLuint>& cached, GLuint value)
+{
+    if (cached == value) {
+        m_stats.avoided++;
+        return false;
+    }
+
+    cached = value;
+    m_stats.changes++;
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef D9A44728_EA1D_456C_AC91_2A65CC424B49
+#define D9A44728_EA1D_456C_AC91_2A65CC424B49
+
+#include "igepch.hpp"
+
+#include "Program.hpp"
+#include "Texture.hpp"
+#include "VertexArray.hpp"
+#include "glad/gl.h"
+#include "ige/core/SmallVector.hpp"
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace gl {
+
+/**
+ * @brief Remembers the state set through it, to skip the GL calls that would
+ * set it to the value it already has.
+ *
+ * Call `reset` after changing any of this state without going through the
+ * cache (e.g. when another renderer ran in between).
+ */
+class StateCache {
+public:
+    struct Stats {
+        // calls actually issued
+        std::size_t changes = 0;
+
+        // calls skipped because the state was already set
+        std::size_t avoided = 0;
+    };
+
+    static constexpr std::size_t TEXTURE_UNITS = 16;
+
+    /**
+     * @brief Forget everything, the next changes are always issued.
+     */
+    void reset();
+
+    void enable(GLenum capability, bool enabled);
+    void use(const Program&);
+    void bind(const VertexArray&);
+    void bind_texture_2d(GLuint unit, const Texture&);
+
+    const Stats& stats() const;
+    void clear_stats();
+
+private:
+    struct Capability {
+        GLenum name;
+        bool enabled;
+    };
+
+    ige::core::SmallVector<Capability, 8> m_capabilities;
+    std::optional<GLuint> m_program;
+    std::optional<GLuint> m_vertex_array;
+    std::optional<GLuint> m_active_texture;
+    std::array<std::optional<GLuint>, TEXTURE_UNITS> m_textures;
+
+    Stats m_stats;
+
+    // update `cached`, returns whether the call must be issued
+    bool change(std::optional<GLuint>& cached, GLuint value);
+};
+
+}
+
+#endif /* D9A44728_EA1D_456C_AC91_2A65CC424B49 */
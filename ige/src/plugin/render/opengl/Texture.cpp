@@ -1,8 +1,10 @@
 #include "igepch.hpp"
 
+#include "Buffer.hpp"
 #include "Texture.hpp"
 #include "glad/gl.h"
 
+using gl::Buffer;
 using gl::Texture;
 
 Texture::Texture()
@@ -43,6 +45,14 @@ void Texture::image_2d(
         static_cast<GLenum>(type), data);
 }
 
+void Texture::buffer(
+    Target target, InternalFormat internal_format, const Buffer& buffer)
+{
+    glTexBuffer(
+        static_cast<GLenum>(target), static_cast<GLenum>(internal_format),
+        buffer.id());
+}
+
 GLuint Texture::id() const
 {
     return m_id;
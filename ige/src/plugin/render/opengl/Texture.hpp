@@ -1,6 +1,7 @@
 #ifndef ED0F4953_C3BE_4C2E_A2BA_C10B4A08B3C8
 #define ED0F4953_C3BE_4C2E_A2BA_C10B4A08B3C8
 
+#include "Buffer.hpp"
 #include "glad/gl.h"
 
 namespace gl {
@@ -9,6 +10,7 @@ class Texture {
 public:
     enum class Target : GLenum {
         TEXTURE_2D = GL_TEXTURE_2D,
+        TEXTURE_BUFFER = GL_TEXTURE_BUFFER,
     };
 
     enum class InternalFormat : GLenum {
@@ -130,6 +132,7 @@ public:
     static void image_2d(
         Target, GLint level, InternalFormat, GLsizei w, GLsizei h, Format, Type,
         const void* data);
+    static void buffer(Target, InternalFormat, const Buffer&);
     static void filter(Target, MagFilter, MinFilter);
     static void wrap(Target, Wrap s, Wrap t);
     static void gen_mipmaps(Target);
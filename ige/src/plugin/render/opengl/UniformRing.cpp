@@ -0,0 +1,153 @@
+#include "igepch.hpp"
+
+#include "Buffer.hpp"
+#include "UniformRing.hpp"
+#include "glad/gl.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+using gl::Buffer;
+using gl::UniformRing;
+
+// regions start big enough for a few hundred skinned meshes
+const std::size_t MIN_REGION_SIZE = 256 * 1024;
+
+// one second, waits are retried until the fence is signaled
+const GLuint64 WAIT_TIMEOUT = 1'000'000'000;
+
+static void wait_and_delete(GLsync& fence)
+{
+    if (!fence) {
+        return;
+    }
+
+    GLenum status;
+
+    do {
+        status = glClientWaitSync(
+            fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+    } while (status == GL_TIMEOUT_EXPIRED);
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+UniformRing::UniformRing()
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+    if (alignment > 0) {
+        m_alignment = static_cast<std::size_t>(alignment);
+    }
+}
+
+UniformRing::UniformRing(UniformRing&& other)
+{
+    *this = std::move(other);
+}
+
+UniformRing& UniformRing::operator=(UniformRing&& other)
+{
+    delete_fences();
+
+    m_buffer = std::move(other.m_buffer);
+    m_alignment = other.m_alignment;
+    m_region_size = std::exchange(other.m_region_size, 0);
+    m_region = std::exchange(other.m_region, 0);
+    m_fences = std::exchange(other.m_fences, {});
+    m_staging = std::move(other.m_staging);
+    return *this;
+}
+
+UniformRing::~UniformRing()
+{
+    delete_fences();
+}
+
+void UniformRing::delete_fences()
+{
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+}
+
+std::size_t UniformRing::align(std::size_t offset) const
+{
+    return (offset + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+std::size_t UniformRing::push(const void* data, std::size_t size)
+{
+    std::size_t offset = align(m_staging.size());
+
+    m_staging.resize(offset + size);
+    std::memcpy(m_staging.data() + offset, data, size);
+
+    return offset;
+}
+
+void UniformRing::upload()
+{
+    if (m_staging.empty()) {
+        return;
+    }
+
+    const auto UNIFORM_BUFFER = Buffer::Target::UNIFORM_BUFFER;
+
+    Buffer::bind(UNIFORM_BUFFER, m_buffer);
+
+    if (m_staging.size() > m_region_size) {
+        // the driver keeps the old storage alive until the GPU is done with
+        // it, only the new one is fenced from now on
+        m_region_size = align(
+            std::bit_ceil(std::max(m_staging.size(), MIN_REGION_SIZE)));
+        m_region = 0;
+
+        Buffer::data(
+            UNIFORM_BUFFER, m_region_size * FRAMES, nullptr,
+            Buffer::Usage::STREAM_DRAW);
+
+        delete_fences();
+    } else {
+        wait_and_delete(m_fences[m_region]);
+    }
+
+    // the fence already synchronized the region, don't let the driver stall
+    void* region = glMapBufferRange(
+        GL_UNIFORM_BUFFER, m_region * m_region_size, m_staging.size(),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+            | GL_MAP_UNSYNCHRONIZED_BIT);
+
+    if (region) {
+        std::memcpy(region, m_staging.data(), m_staging.size());
+        Buffer::unmap(UNIFORM_BUFFER);
+    }
+
+    Buffer::unbind(UNIFORM_BUFFER);
+}
+
+void UniformRing::bind(
+    GLuint binding, std::size_t offset, std::size_t size) const
+{
+    Buffer::bind_range(
+        Buffer::Target::UNIFORM_BUFFER, binding, m_buffer,
+        static_cast<GLintptr>(m_region * m_region_size + offset),
+        static_cast<GLsizeiptr>(size));
+}
+
+void UniformRing::end_frame()
+{
+    if (m_staging.empty()) {
+        return;
+    }
+
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_region = (m_region + 1) % FRAMES;
+    m_staging.clear();
+}
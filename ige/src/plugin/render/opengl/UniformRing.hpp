@@ -0,0 +1,75 @@
+#ifndef B0D17E45_035E_417D_B887_EA87EA3CF189
+#define B0D17E45_035E_417D_B887_EA87EA3CF189
+
+#include "igepch.hpp"
+
+#include "Buffer.hpp"
+#include "glad/gl.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace gl {
+
+/**
+ * @brief Uniform buffer sub-allocated from scratch every frame.
+ *
+ * The buffer is split in `FRAMES` regions: the CPU fills one while the GPU
+ * may still be reading the previous ones. Each region is fenced at the end of
+ * its frame, and only written again once the GPU is done with it.
+ *
+ * Blocks are staged with `push`, copied to the current region at once by
+ * `upload`, and can then be bound with `bind` until `end_frame`.
+ */
+class UniformRing {
+public:
+    static constexpr std::size_t FRAMES = 3;
+
+    UniformRing();
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+    UniformRing(UniformRing&& other);
+    UniformRing& operator=(UniformRing&& other);
+    ~UniformRing();
+
+    /**
+     * @brief Stage a block, returns its offset in the current frame.
+     */
+    std::size_t push(const void* data, std::size_t size);
+
+    template <typename T>
+    std::size_t push(const T& block)
+    {
+        return push(&block, sizeof(T));
+    }
+
+    /**
+     * @brief Copy the blocks staged so far to the current region.
+     *
+     * Blocks can't be pushed anymore until the next frame.
+     */
+    void upload();
+
+    void bind(GLuint binding, std::size_t offset, std::size_t size) const;
+
+    /**
+     * @brief Fence the current region (after its last draw call) and move on
+     * to the next one.
+     */
+    void end_frame();
+
+private:
+    Buffer m_buffer;
+    std::size_t m_alignment = 256;
+    std::size_t m_region_size = 0;
+    std::size_t m_region = 0;
+    std::array<GLsync, FRAMES> m_fences {};
+    std::vector<std::byte> m_staging;
+
+    std::size_t align(std::size_t offset) const;
+    void delete_fences();
+};
+
+}
+
+#endif /* B0D17E45_035E_417D_B887_EA87EA3CF189 */
@@ -94,3 +94,9 @@ void VertexArray::attrib(GLuint idx, std::span<const vec4> data)
 {
     attrib(idx, 4, VertexArray::Type::FLOAT, data);
 }
+
+void VertexArray::divisor(GLuint idx, GLuint divisor)
+{
+    bind();
+    glVertexAttribDivisor(idx, divisor);
+}
@@ -39,6 +39,12 @@ public:
     void attrib(GLuint idx, std::span<const glm::vec3> data);
     void attrib(GLuint idx, std::span<const glm::vec4> data);
 
+    /**
+     * @brief Advance attribute `idx` once every `divisor` instances instead of
+     * once per vertex (0).
+     */
+    void divisor(GLuint idx, GLuint divisor);
+
 private:
     GLuint m_id = 0;
     std::vector<gl::Buffer> m_buffers;
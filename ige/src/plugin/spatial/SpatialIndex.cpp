@@ -0,0 +1,385 @@
+#include "igepch.hpp"
+
+#include "ige/core/Bounds.hpp"
+#include "ige/core/SmallVector.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/plugin/spatial/SpatialIndex.hpp"
+#include <bit>
+#include <glm/common.hpp>
+#include <glm/vec3.hpp>
+
+using glm::vec3;
+using ige::core::Aabb;
+using ige::core::BoundingSphere;
+using ige::core::Frustum;
+using ige::core::Ray;
+using ige::core::SmallVector;
+using ige::ecs::EntityId;
+using ige::plugin::spatial::SpatialIndex;
+
+SpatialIndex::SpatialIndex(float margin)
+    : m_margin(margin)
+{
+}
+
+bool SpatialIndex::Node::is_leaf() const
+{
+    return children[0] == NONE;
+}
+
+void SpatialIndex::update(EntityId entity, const Aabb& box)
+{
+    std::size_t index = entity.index();
+
+    if (index >= m_leaves.size()) {
+        m_leaves.resize(index + 1, NONE);
+    }
+
+    std::uint32_t leaf = m_leaves[index];
+
+    if (leaf != NONE) {
+        if (m_nodes[leaf].entity == entity && m_nodes[leaf].box.contains(box)) {
+            return;
+        }
+
+        // moved too far, or another entity reusing the same index
+        remove_leaf(leaf);
+    } else {
+        leaf = allocate();
+        m_leaves[index] = leaf;
+        m_size++;
+    }
+
+    Node& node = m_nodes[leaf];
+    node.box = box.inflated((box.max - box.min) * m_margin);
+    node.entity = entity;
+    node.height = 0;
+    node.children[0] = NONE;
+    node.children[1] = NONE;
+
+    insert_leaf(leaf);
+}
+
+void SpatialIndex::remove(EntityId entity)
+{
+    if (!contains(entity)) {
+        return;
+    }
+
+    std::uint32_t& leaf = m_leaves[entity.index()];
+
+    remove_leaf(leaf);
+    release(leaf);
+    leaf = NONE;
+    m_size--;
+}
+
+bool SpatialIndex::contains(EntityId entity) const
+{
+    std::size_t index = entity.index();
+
+    return index < m_leaves.size() && m_leaves[index] != NONE
+        && m_nodes[m_leaves[index]].entity == entity;
+}
+
+std::size_t SpatialIndex::size() const
+{
+    return m_size;
+}
+
+std::size_t SpatialIndex::height() const
+{
+    return m_root == NONE ? 0 : m_nodes[m_root].height;
+}
+
+bool SpatialIndex::balanced() const
+{
+    // a perfectly balanced tree would have a height of log2(size)
+    std::size_t optimal = std::bit_width(m_size);
+
+    return height() <= 2 * optimal + 4;
+}
+
+void SpatialIndex::rebalance()
+{
+    std::vector<std::uint32_t> leaves;
+    leaves.reserve(m_size);
+
+    for (std::uint32_t i = 0; i < m_nodes.size(); i++) {
+        const Node& node = m_nodes[i];
+
+        // free nodes are detached from the tree
+        if (node.parent == NONE && i != m_root) {
+            continue;
+        }
+
+        if (node.is_leaf()) {
+            leaves.push_back(i);
+        } else {
+            release(i);
+        }
+    }
+
+    m_root = leaves.empty() ? NONE : build(leaves.begin(), leaves.end());
+}
+
+void SpatialIndex::query(const Aabb& box, std::vector<EntityId>& out) const
+{
+    traverse(
+        [&](const Aabb& node) { return node.intersects(box); },
+        [](const Aabb&) { return false; }, out);
+}
+
+void SpatialIndex::query(
+    const BoundingSphere& sphere, std::vector<EntityId>& out) const
+{
+    traverse(
+        [&](const Aabb& node) { return node.intersects(sphere); },
+        [](const Aabb&) { return false; }, out);
+}
+
+void SpatialIndex::query(
+    const Frustum& frustum, std::vector<EntityId>& out) const
+{
+    // subtrees entirely inside the frustum are collected without more tests
+    traverse(
+        [&](const Aabb& node) { return frustum.intersects(node); },
+        [&](const Aabb& node) { return frustum.contains(node); }, out);
+}
+
+void SpatialIndex::query(
+    const Ray& ray, float max_distance, std::vector<EntityId>& out) const
+{
+    traverse(
+        [&](const Aabb& node) { return node.intersects(ray, max_distance); },
+        [](const Aabb&) { return false; }, out);
+}
+
+template <typename Test, typename Contains>
+void SpatialIndex::traverse(
+    const Test& test, const Contains& contains,
+    std::vector<EntityId>& out) const
+{
+    out.clear();
+
+    if (m_root == NONE) {
+        return;
+    }
+
+    struct Pending {
+        std::uint32_t node;
+        bool inside;
+    };
+
+    // deep enough for any balanced tree, only allocates past that
+    SmallVector<Pending, 64> stack;
+    stack.push_back({ m_root, false });
+
+    while (!stack.empty()) {
+        Pending pending = stack.back();
+        stack.pop_back();
+
+        const Node& node = m_nodes[pending.node];
+        bool inside = pending.inside;
+
+        if (!inside) {
+            if (!test(node.box)) {
+                continue;
+            }
+
+            inside = !node.is_leaf() && contains(node.box);
+        }
+
+        if (node.is_leaf()) {
+            out.push_back(node.entity);
+        } else {
+            stack.push_back({ node.children[0], inside });
+            stack.push_back({ node.children[1], inside });
+        }
+    }
+}
+
+std::uint32_t SpatialIndex::allocate()
+{
+    if (!m_free.empty()) {
+        std::uint32_t node = m_free.back();
+        m_free.pop_back();
+        return node;
+    }
+
+    m_nodes.emplace_back();
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
+
+void SpatialIndex::release(std::uint32_t node)
+{
+    m_nodes[node].parent = NONE;
+    m_nodes[node].children[0] = NONE;
+    m_nodes[node].children[1] = NONE;
+    m_free.push_back(node);
+}
+
+void SpatialIndex::insert_leaf(std::uint32_t leaf)
+{
+    if (m_root == NONE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NONE;
+        return;
+    }
+
+    const Aabb box = m_nodes[leaf].box;
+
+    // go down where the surface area increases the least
+    std::uint32_t sibling = m_root;
+
+    while (!m_nodes[sibling].is_leaf()) {
+        const Node& node = m_nodes[sibling];
+        float area = node.box.surface_area();
+        float combined = node.box.merged(box).surface_area();
+
+        // cost of making a new parent for this node and the leaf
+        float cost = 2.0f * combined;
+
+        // minimum cost of pushing the leaf further down
+        float inheritance = 2.0f * (combined - area);
+
+        auto descend_cost = [&](std::uint32_t child) {
+            const Aabb& child_box = m_nodes[child].box;
+            float merged = child_box.merged(box).surface_area();
+
+            if (m_nodes[child].is_leaf()) {
+                return merged + inheritance;
+            } else {
+                return merged - child_box.surface_area() + inheritance;
+            }
+        };
+
+        float cost0 = descend_cost(node.children[0]);
+        float cost1 = descend_cost(node.children[1]);
+
+        if (cost < cost0 && cost < cost1) {
+            break;
+        }
+
+        sibling = cost0 < cost1 ? node.children[0] : node.children[1];
+    }
+
+    std::uint32_t old_parent = m_nodes[sibling].parent;
+    std::uint32_t parent = allocate();
+
+    Node& node = m_nodes[parent];
+    node.parent = old_parent;
+    node.children[0] = sibling;
+    node.children[1] = leaf;
+    node.box = box.merged(m_nodes[sibling].box);
+    node.height = m_nodes[sibling].height + 1;
+
+    if (old_parent == NONE) {
+        m_root = parent;
+    } else {
+        Node& grandparent = m_nodes[old_parent];
+        int side = grandparent.children[0] == sibling ? 0 : 1;
+
+        grandparent.children[side] = parent;
+    }
+
+    m_nodes[sibling].parent = parent;
+    m_nodes[leaf].parent = parent;
+
+    refit(old_parent);
+}
+
+void SpatialIndex::remove_leaf(std::uint32_t leaf)
+{
+    if (leaf == m_root) {
+        m_root = NONE;
+        return;
+    }
+
+    // the sibling takes the place of the parent
+    std::uint32_t parent = m_nodes[leaf].parent;
+    std::uint32_t grandparent = m_nodes[parent].parent;
+    std::uint32_t sibling = m_nodes[parent].children[0] == leaf
+        ? m_nodes[parent].children[1]
+        : m_nodes[parent].children[0];
+
+    if (grandparent == NONE) {
+        m_root = sibling;
+    } else {
+        Node& node = m_nodes[grandparent];
+        int side = node.children[0] == parent ? 0 : 1;
+
+        node.children[side] = sibling;
+    }
+
+    m_nodes[sibling].parent = grandparent;
+    m_nodes[leaf].parent = NONE;
+    release(parent);
+
+    refit(grandparent);
+}
+
+void SpatialIndex::refit(std::uint32_t index)
+{
+    while (index != NONE) {
+        Node& node = m_nodes[index];
+        const Node& a = m_nodes[node.children[0]];
+        const Node& b = m_nodes[node.children[1]];
+
+        node.box = a.box.merged(b.box);
+        node.height = std::max(a.height, b.height) + 1;
+        index = node.parent;
+    }
+}
+
+std::uint32_t SpatialIndex::build(
+    std::vector<std::uint32_t>::iterator first,
+    std::vector<std::uint32_t>::iterator last)
+{
+    if (last - first == 1) {
+        m_nodes[*first].parent = NONE;
+        return *first;
+    }
+
+    Aabb centers { m_nodes[*first].box.center(), m_nodes[*first].box.center() };
+
+    for (auto it = first; it != last; ++it) {
+        vec3 center = m_nodes[*it].box.center();
+
+        centers.min = glm::min(centers.min, center);
+        centers.max = glm::max(centers.max, center);
+    }
+
+    vec3 size = centers.max - centers.min;
+    int axis = 0;
+
+    if (size.y > size[axis]) {
+        axis = 1;
+    }
+
+    if (size.z > size[axis]) {
+        axis = 2;
+    }
+
+    auto middle = first + (last - first) / 2;
+
+    std::nth_element(first, middle, last, [&](auto a, auto b) {
+        return m_nodes[a].box.center()[axis] < m_nodes[b].box.center()[axis];
+    });
+
+    std::uint32_t left = build(first, middle);
+    std::uint32_t right = build(middle, last);
+    std::uint32_t parent = allocate();
+
+    Node& node = m_nodes[parent];
+    node.parent = NONE;
+    node.children[0] = left;
+    node.children[1] = right;
+    node.box = m_nodes[left].box.merged(m_nodes[right].box);
+    node.height = std::max(m_nodes[left].height, m_nodes[right].height) + 1;
+
+    m_nodes[left].parent = parent;
+    m_nodes[right].parent = parent;
+
+    return parent;
+}
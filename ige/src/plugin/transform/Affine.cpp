@@ -0,0 +1,241 @@
+#include "igepch.hpp"
+
+#include "ige/plugin/transform/Affine.hpp"
+
+#if defined(__SSE__) || defined(_M_X64)                                        \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define IGE_AFFINE_SSE
+#include <xmmintrin.h>
+#endif
+
+using glm::mat4;
+using glm::quat;
+using glm::vec3;
+using glm::vec4;
+using ige::plugin::transform::Affine;
+
+Affine Affine::operator*(const Affine& b) const
+{
+    const Affine& a = *this;
+    Affine res;
+
+#ifdef IGE_AFFINE_SSE
+    const __m128 b0 = _mm_loadu_ps(&b.rows[0].x);
+    const __m128 b1 = _mm_loadu_ps(&b.rows[1].x);
+    const __m128 b2 = _mm_loadu_ps(&b.rows[2].x);
+    const __m128 b3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < 3; i++) {
+        const __m128 row = _mm_loadu_ps(&a.rows[i].x);
+
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), b0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), b1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xAA), b2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xFF), b3));
+
+        _mm_storeu_ps(&res.rows[i].x, r);
+    }
+#else
+    for (int i = 0; i < 3; i++) {
+        const vec4& row = a.rows[i];
+
+        res.rows[i] = b.rows[0] * row.x + b.rows[1] * row.y
+            + b.rows[2] * row.z + vec4(0.0f, 0.0f, 0.0f, row.w);
+    }
+#endif
+
+    return res;
+}
+
+Affine Affine::inverse() const
+{
+    const Affine& a = *this;
+    const vec4& r0 = a.rows[0];
+    const vec4& r1 = a.rows[1];
+    const vec4& r2 = a.rows[2];
+
+    // cofactors of the upper-left 3x3 block
+    const float c00 = r1.y * r2.z - r1.z * r2.y;
+    const float c01 = r1.z * r2.x - r1.x * r2.z;
+    const float c02 = r1.x * r2.y - r1.y * r2.x;
+    const float inv_det = 1.0f / (r0.x * c00 + r0.y * c01 + r0.z * c02);
+
+    Affine res;
+    vec4& i0 = res.rows[0];
+    vec4& i1 = res.rows[1];
+    vec4& i2 = res.rows[2];
+
+    i0.x = c00 * inv_det;
+    i0.y = (r0.z * r2.y - r0.y * r2.z) * inv_det;
+    i0.z = (r0.y * r1.z - r0.z * r1.y) * inv_det;
+    i1.x = c01 * inv_det;
+    i1.y = (r0.x * r2.z - r0.z * r2.x) * inv_det;
+    i1.z = (r0.z * r1.x - r0.x * r1.z) * inv_det;
+    i2.x = c02 * inv_det;
+    i2.y = (r0.y * r2.x - r0.x * r2.y) * inv_det;
+    i2.z = (r0.x * r1.y - r0.y * r1.x) * inv_det;
+
+    // the translation is moved back by the inverse of the linear part
+    i0.w = -(i0.x * r0.w + i0.y * r1.w + i0.z * r2.w);
+    i1.w = -(i1.x * r0.w + i1.y * r1.w + i1.z * r2.w);
+    i2.w = -(i2.x * r0.w + i2.y * r1.w + i2.z * r2.w);
+
+    return res;
+}
+
+Affine Affine::from_mat4(const mat4& m)
+{
+    Affine res;
+
+    for (int i = 0; i < 3; i++) {
+        res.rows[i] = vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    }
+
+    return res;
+}
+
+mat4 Affine::to_mat4() const
+{
+    mat4 res(1.0f);
+
+    for (int i = 0; i < 4; i++) {
+        float w = i == 3 ? 1.0f : 0.0f;
+
+        res[i] = vec4(rows[0][i], rows[1][i], rows[2][i], w);
+    }
+
+    return res;
+}
+
+// rotation matrix of a quaternion, as computed by glm::mat3_cast
+struct Rotation {
+    float m00, m01, m02;
+    float m10, m11, m12;
+    float m20, m21, m22;
+};
+
+static Rotation rotation_of(quat q)
+{
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    return {
+        1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy),
+        2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),
+        2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy),
+    };
+}
+
+Affine Affine::from_trs(vec3 t, quat q, vec3 s)
+{
+    const Rotation r = rotation_of(q);
+    Affine res;
+
+    res.rows[0] = vec4(r.m00 * s.x, r.m01 * s.y, r.m02 * s.z, t.x);
+    res.rows[1] = vec4(r.m10 * s.x, r.m11 * s.y, r.m12 * s.z, t.y);
+    res.rows[2] = vec4(r.m20 * s.x, r.m21 * s.y, r.m22 * s.z, t.z);
+    return res;
+}
+
+#ifdef IGE_AFFINE_SSE
+
+// components of 4 consecutive elements, one per lane
+struct Lanes {
+    __m128 tx, ty, tz;
+    __m128 qx, qy, qz, qw;
+    __m128 sx, sy, sz;
+
+    Lanes(const vec3* t, const quat* q, const vec3* s)
+        : tx(_mm_setr_ps(t[0].x, t[1].x, t[2].x, t[3].x))
+        , ty(_mm_setr_ps(t[0].y, t[1].y, t[2].y, t[3].y))
+        , tz(_mm_setr_ps(t[0].z, t[1].z, t[2].z, t[3].z))
+        , qx(_mm_setr_ps(q[0].x, q[1].x, q[2].x, q[3].x))
+        , qy(_mm_setr_ps(q[0].y, q[1].y, q[2].y, q[3].y))
+        , qz(_mm_setr_ps(q[0].z, q[1].z, q[2].z, q[3].z))
+        , qw(_mm_setr_ps(q[0].w, q[1].w, q[2].w, q[3].w))
+        , sx(_mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x))
+        , sy(_mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y))
+        , sz(_mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z))
+    {
+    }
+};
+
+struct RotationLanes {
+    __m128 m00, m01, m02;
+    __m128 m10, m11, m12;
+    __m128 m20, m21, m22;
+
+    RotationLanes(const Lanes& l)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+
+        const __m128 xx = _mm_mul_ps(l.qx, l.qx);
+        const __m128 yy = _mm_mul_ps(l.qy, l.qy);
+        const __m128 zz = _mm_mul_ps(l.qz, l.qz);
+        const __m128 xy = _mm_mul_ps(l.qx, l.qy);
+        const __m128 xz = _mm_mul_ps(l.qx, l.qz);
+        const __m128 yz = _mm_mul_ps(l.qy, l.qz);
+        const __m128 wx = _mm_mul_ps(l.qw, l.qx);
+        const __m128 wy = _mm_mul_ps(l.qw, l.qy);
+        const __m128 wz = _mm_mul_ps(l.qw, l.qz);
+
+        m00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+        m01 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+        m02 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+        m10 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+        m11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+        m12 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+        m20 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+        m21 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+        m22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+    }
+};
+
+// transpose lanes back into one row for each of the 4 elements
+static void store_row(
+    Affine* out, int row, __m128 a, __m128 b, __m128 c, __m128 d)
+{
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(&out[0].rows[row].x, a);
+    _mm_storeu_ps(&out[1].rows[row].x, b);
+    _mm_storeu_ps(&out[2].rows[row].x, c);
+    _mm_storeu_ps(&out[3].rows[row].x, d);
+}
+
+static void trs_to_affine_x4(
+    const vec3* t, const quat* q, const vec3* s, Affine* out)
+{
+    const Lanes l(t, q, s);
+    const RotationLanes r(l);
+
+    store_row(
+        out, 0, _mm_mul_ps(r.m00, l.sx), _mm_mul_ps(r.m01, l.sy),
+        _mm_mul_ps(r.m02, l.sz), l.tx);
+    store_row(
+        out, 1, _mm_mul_ps(r.m10, l.sx), _mm_mul_ps(r.m11, l.sy),
+        _mm_mul_ps(r.m12, l.sz), l.ty);
+    store_row(
+        out, 2, _mm_mul_ps(r.m20, l.sx), _mm_mul_ps(r.m21, l.sy),
+        _mm_mul_ps(r.m22, l.sz), l.tz);
+}
+
+#endif
+
+void Affine::from_trs(
+    std::span<const vec3> translations, std::span<const quat> rotations,
+    std::span<const vec3> scales, std::span<Affine> out)
+{
+    std::size_t i = 0;
+
+#ifdef IGE_AFFINE_SSE
+    for (; i + 4 <= out.size(); i += 4) {
+        trs_to_affine_x4(&translations[i], &rotations[i], &scales[i], &out[i]);
+    }
+#endif
+
+    for (; i < out.size(); i++) {
+        out[i] = from_trs(translations[i], rotations[i], scales[i]);
+    }
+}
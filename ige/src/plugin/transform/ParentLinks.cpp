@@ -0,0 +1,111 @@
+#include "igepch.hpp"
+
+#include "ParentLinks.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+
+using ige::ecs::EntityId;
+using ige::ecs::World;
+using ige::plugin::transform::Children;
+using ige::plugin::transform::Parent;
+
+template <typename S>
+static std::optional<std::uint64_t> version_of(const S* storage)
+{
+    if (storage) {
+        return storage->version();
+    } else {
+        return std::nullopt;
+    }
+}
+
+void ParentLinks::sync(World& world)
+{
+    auto parents_version = version_of(world.get_component_storage<Parent>());
+    auto children_version = version_of(world.get_component_storage<Children>());
+
+    // components were neither added nor removed: the hierarchy didn't change
+    if (parents_version == m_parents_version
+        && children_version == m_children_version) {
+        return;
+    }
+
+    std::vector<bool> seen(m_links.size(), false);
+    std::vector<EntityId> orphans;
+
+    for (auto [child, parent] : world.query<Parent>()) {
+        std::size_t index = child.index();
+
+        if (index >= m_links.size()) {
+            m_links.resize(index + 1);
+            seen.resize(index + 1, false);
+        }
+
+        seen[index] = true;
+
+        if (world.entity_at(parent.entity().index()) != parent.entity()) {
+            unlink(world, index);
+            orphans.push_back(child);
+            continue;
+        }
+
+        const auto& prev = m_links[index];
+
+        if (prev && prev->child == child && prev->parent == parent.entity()) {
+            continue;
+        }
+
+        unlink(world, index);
+        link(world, child, parent.entity());
+    }
+
+    // children that lost their parent since the last sync
+    for (std::size_t index = 0; index < m_links.size(); index++) {
+        if (!seen[index] && m_links[index]) {
+            unlink(world, index);
+        }
+    }
+
+    m_parents_version = version_of(world.get_component_storage<Parent>());
+    m_children_version = version_of(world.get_component_storage<Children>());
+
+    // orphans are removed after saving the versions so that the next sync
+    // notices it, and removes their own children (if any) in turn
+    for (auto orphan : orphans) {
+        world.remove_entity(orphan);
+    }
+}
+
+std::uint64_t ParentLinks::version() const
+{
+    return m_version;
+}
+
+void ParentLinks::link(World& world, EntityId child, EntityId parent)
+{
+    world.get_or_emplace_component<Children>(parent).entities.push_back(child);
+    m_links[child.index()] = Link { child, parent };
+    m_version++;
+}
+
+void ParentLinks::unlink(World& world, std::size_t child_index)
+{
+    auto& link = m_links[child_index];
+
+    if (!link) {
+        return;
+    }
+
+    if (auto children = world.get_component<Children>(link->parent)) {
+        auto& entities = children->entities;
+        auto it = std::find(entities.begin(), entities.end(), link->child);
+
+        if (it != entities.end()) {
+            entities.erase(it);
+        }
+    }
+
+    link.reset();
+    m_version++;
+}
@@ -0,0 +1,53 @@
+#ifndef F9F4CC55_2FF6_4CC6_ACB4_5243E3166D9A
+#define F9F4CC55_2FF6_4CC6_ACB4_5243E3166D9A
+
+#include "igepch.hpp"
+
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Keeps the `Children` components in sync with the `Parent` components.
+ *
+ * It remembers which parent each child was linked to, so that only the
+ * entities whose `Parent` changed are moved from one `Children` list to
+ * another. When neither the `Parent` nor the `Children` storage changed since
+ * the last sync, nothing is done at all.
+ */
+class ParentLinks {
+public:
+    /**
+     * @brief Update the `Children` components according to the `Parent`
+     * components added, replaced or removed since the last call.
+     *
+     * Entities whose parent doesn't exist anymore are removed.
+     */
+    void sync(ige::ecs::World&);
+
+    /**
+     * @brief Number of times a child was linked to or unlinked from a parent.
+     */
+    std::uint64_t version() const;
+
+private:
+    struct Link {
+        ige::ecs::EntityId child;
+        ige::ecs::EntityId parent;
+    };
+
+    // indexed by the index of the child entity
+    std::vector<std::optional<Link>> m_links;
+    std::uint64_t m_version = 0;
+
+    std::optional<std::uint64_t> m_parents_version;
+    std::optional<std::uint64_t> m_children_version;
+
+    void link(ige::ecs::World&, ige::ecs::EntityId child,
+              ige::ecs::EntityId parent);
+    void unlink(ige::ecs::World&, std::size_t child_index);
+};
+
+#endif /* F9F4CC55_2FF6_4CC6_ACB4_5243E3166D9A */
@@ -5,10 +5,68 @@
 using glm::vec2;
 using ige::plugin::transform::RectTransform;
 
+RectTransform::RectTransform(const RectTransform& other)
+    : m_bounds_min(other.m_bounds_min)
+    , m_bounds_max(other.m_bounds_max)
+    , m_anchors_min(other.m_anchors_min)
+    , m_anchors_max(other.m_anchors_max)
+    , m_abs_bounds_min(other.m_abs_bounds_min)
+    , m_abs_bounds_max(other.m_abs_bounds_max)
+    , m_abs_depth(other.m_abs_depth)
+    , m_dirty(other.m_dirty)
+{
+}
+
+RectTransform& RectTransform::operator=(const RectTransform& other)
+{
+    m_bounds_min = other.m_bounds_min;
+    m_bounds_max = other.m_bounds_max;
+    m_anchors_min = other.m_anchors_min;
+    m_anchors_max = other.m_anchors_max;
+    m_abs_bounds_min = other.m_abs_bounds_min;
+    m_abs_bounds_max = other.m_abs_bounds_max;
+    m_abs_depth = other.m_abs_depth;
+
+    // we keep our place in the hierarchy, but must be laid out relative to
+    // our own parent
+    mark_dirty();
+    return *this;
+}
+
+void RectTransform::mark_dirty()
+{
+    if (!m_dirty && m_changes) {
+        m_changes->push_back(m_node);
+    }
+
+    m_dirty = true;
+}
+
+vec2 RectTransform::bounds_min() const
+{
+    return m_bounds_min;
+}
+
+vec2 RectTransform::bounds_max() const
+{
+    return m_bounds_max;
+}
+
+vec2 RectTransform::anchors_min() const
+{
+    return m_anchors_min;
+}
+
+vec2 RectTransform::anchors_max() const
+{
+    return m_anchors_max;
+}
+
 RectTransform& RectTransform::set_bounds(vec2 min, vec2 max) &
 {
-    bounds_min = min;
-    bounds_max = max;
+    m_bounds_min = min;
+    m_bounds_max = max;
+    mark_dirty();
     return *this;
 }
 
@@ -19,8 +77,9 @@ RectTransform RectTransform::set_bounds(vec2 min, vec2 max) &&
 
 RectTransform& RectTransform::set_anchors(vec2 min, vec2 max) &
 {
-    anchors_min = min;
-    anchors_max = max;
+    m_anchors_min = min;
+    m_anchors_max = max;
+    mark_dirty();
     return *this;
 }
 
@@ -45,13 +104,19 @@ void RectTransform::force_update(
 {
     const auto parent_size = parent_abs_bounds_max - parent_abs_bounds_min;
     const auto anchors_min_abs
-        = parent_abs_bounds_min + parent_size * anchors_min;
+        = parent_abs_bounds_min + parent_size * m_anchors_min;
     const auto anchors_max_abs
-        = parent_abs_bounds_min + parent_size * anchors_max;
+        = parent_abs_bounds_min + parent_size * m_anchors_max;
 
-    m_abs_bounds_min = anchors_min_abs + bounds_min;
-    m_abs_bounds_max = anchors_max_abs + bounds_max;
+    m_abs_bounds_min = anchors_min_abs + m_bounds_min;
+    m_abs_bounds_max = anchors_max_abs + m_bounds_max;
     m_abs_depth = abs_depth;
+    m_dirty = false;
+}
+
+bool RectTransform::needs_update() const
+{
+    return m_dirty;
 }
 
 glm::vec2 RectTransform::abs_bounds_min() const
@@ -7,9 +7,42 @@ using glm::mat4;
 using glm::quat;
 using glm::vec3;
 using glm::vec4;
+using ige::plugin::transform::Affine;
 using ige::plugin::transform::Parent;
 using ige::plugin::transform::Transform;
 
+Transform::Transform(const Transform& other)
+    : m_translation(other.m_translation)
+    , m_rotation(other.m_rotation)
+    , m_scale(other.m_scale)
+    , m_dirty(other.m_dirty)
+    , m_local_to_world(other.m_local_to_world)
+{
+}
+
+Transform& Transform::operator=(const Transform& other)
+{
+    m_translation = other.m_translation;
+    m_rotation = other.m_rotation;
+    m_scale = other.m_scale;
+    m_local_to_world = other.m_local_to_world;
+    m_world_to_local_stale = true;
+
+    // we keep our place in the hierarchy, but the world transform must be
+    // recomputed relative to our own parent
+    mark_dirty();
+    return *this;
+}
+
+void Transform::mark_dirty()
+{
+    if (!m_dirty && m_changes) {
+        m_changes->push_back(m_node);
+    }
+
+    m_dirty = true;
+}
+
 Transform Transform::from_pos(vec3 position)
 {
     Transform xform;
@@ -41,14 +74,14 @@ vec3 Transform::scale() const
 Transform& Transform::set_translation(vec3 value) &
 {
     m_translation = value;
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
 Transform& Transform::set_rotation(quat value) &
 {
     m_rotation = value;
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
@@ -57,14 +90,14 @@ Transform& Transform::set_rotation(vec3 angles) &
     m_rotation = { 1.0f, 0.0f, 0.0f, 0.0f };
     rotate(angles);
     // rotate() already set the dirty flag
-    // m_dirty = true;
+    // mark_dirty();
     return *this;
 }
 
 Transform& Transform::set_scale(vec3 value) &
 {
     m_scale = value;
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
@@ -76,7 +109,7 @@ Transform& Transform::set_scale(float value) &
 Transform& Transform::translate(vec3 v)
 {
     m_translation += v;
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
@@ -90,21 +123,21 @@ Transform& Transform::rotate(vec3 angles)
     m_rotation = glm::rotate(m_rotation, glm::radians(angles.z), Z_AXIS);
     m_rotation = glm::rotate(m_rotation, glm::radians(angles.x), X_AXIS);
     m_rotation = glm::rotate(m_rotation, glm::radians(angles.y), Y_AXIS);
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
 Transform& Transform::rotate(quat rot)
 {
     m_rotation *= rot;
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
 Transform& Transform::scale(vec3 f)
 {
     m_scale *= f;
-    m_dirty = true;
+    mark_dirty();
     return *this;
 }
 
@@ -146,12 +179,20 @@ Transform Transform::look_at(vec3 target, vec3 up) &&
 
 void Transform::force_update(const mat4& parent)
 {
-    mat4 mat = parent;
+    Affine local = Affine::from_trs(m_translation, m_rotation, m_scale);
 
-    mat = glm::translate(mat, m_translation) * glm::mat4_cast(m_rotation);
-    m_local_to_world = glm::scale(mat, m_scale);
-    m_world_to_local = glm::inverse(m_local_to_world);
+    set_world(Affine::from_mat4(parent) * local);
+}
 
+void Transform::force_update(const Transform& parent)
+{
+    force_update(parent.m_local_to_world);
+}
+
+void Transform::set_world(const Affine& world)
+{
+    m_local_to_world = world.to_mat4();
+    m_world_to_local_stale = true;
     m_dirty = false;
 }
 
@@ -167,5 +208,15 @@ const mat4& Transform::local_to_world() const
 
 const mat4& Transform::world_to_local() const
 {
-    return m_world_to_local;
+    if (!m_world_to_local) {
+        m_world_to_local = std::make_unique<mat4>(1.0f);
+    }
+
+    if (m_world_to_local_stale) {
+        *m_world_to_local
+            = Affine::from_mat4(m_local_to_world).inverse().to_mat4();
+        m_world_to_local_stale = false;
+    }
+
+    return *m_world_to_local;
 }
@@ -0,0 +1,398 @@
+#include "igepch.hpp"
+
+#include "TransformHierarchy.hpp"
+#include "ige/core/ThreadPool.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+
+using glm::vec2;
+using ige::core::ThreadPool;
+using ige::ecs::EntityId;
+using ige::ecs::StorageOf;
+using ige::ecs::World;
+using ige::plugin::transform::Affine;
+using ige::plugin::transform::Children;
+using ige::plugin::transform::Parent;
+using ige::plugin::transform::RectTransform;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::WorldBounds;
+
+void TransformHierarchy::rebuild(World& world)
+{
+    m_version++;
+
+    struct Pending {
+        EntityId entity;
+        std::size_t parent;
+    };
+
+    m_nodes.clear();
+
+    std::vector<Pending> stack;
+
+    for (auto [entity, xform] : world.query<Transform>()) {
+        // only start from tree roots (entities without a parent)
+        if (!world.get_component<Parent>(entity)) {
+            stack.push_back({ entity, NO_PARENT });
+        }
+    }
+
+    // roots without a transform (e.g. UI elements) can have children too
+    for (auto [entity, children] : world.query<Children>()) {
+        if (!world.get_component<Parent>(entity)
+            && !world.get_component<Transform>(entity)) {
+            stack.push_back({ entity, NO_PARENT });
+        }
+    }
+
+    for (auto [entity, rect] : world.query<RectTransform>()) {
+        if (!world.get_component<Parent>(entity)
+            && !world.get_component<Transform>(entity)
+            && !world.get_component<Children>(entity)) {
+            stack.push_back({ entity, NO_PARENT });
+        }
+    }
+
+    // roots were pushed in storage order, pop them in that order too
+    std::reverse(stack.begin(), stack.end());
+
+    while (!stack.empty()) {
+        Pending pending = stack.back();
+        stack.pop_back();
+
+        std::size_t index = m_nodes.size();
+        m_nodes.push_back({ pending.entity, pending.parent, index + 1 });
+
+        if (auto children = world.get_component<Children>(pending.entity)) {
+            for (auto child : children->entities) {
+                stack.push_back({ child, index });
+            }
+        }
+    }
+
+    // children come after their parent: extend subtrees bottom-up
+    for (std::size_t i = m_nodes.size(); i-- > 0;) {
+        const Node& node = m_nodes[i];
+
+        if (node.parent != NO_PARENT) {
+            Node& parent = m_nodes[node.parent];
+            parent.subtree_end = std::max(parent.subtree_end, node.subtree_end);
+        }
+    }
+
+    auto transforms = world.get_component_storage<Transform>();
+    auto rects = world.get_component_storage<RectTransform>();
+    std::vector<std::optional<Built>> built;
+
+    m_changes->clear();
+    m_rect_changes->clear();
+
+    for (std::size_t i = 0; i < m_nodes.size(); i++) {
+        const Node& node = m_nodes[i];
+        std::size_t index = node.entity.index();
+        std::optional<EntityId> parent;
+
+        if (node.parent != NO_PARENT) {
+            parent = m_nodes[node.parent].entity;
+        }
+
+        if (index >= built.size()) {
+            built.resize(index + 1);
+        }
+
+        built[index] = Built { node.entity, parent, i };
+
+        // new or reparented nodes must be updated even if they aren't dirty
+        bool moved = index >= m_built.size() || !m_built[index]
+            || m_built[index]->entity != node.entity
+            || m_built[index]->parent != parent;
+
+        // node indices changed: transforms must report the new ones
+        if (Transform* xform = transforms ? transforms->get(index) : nullptr) {
+            xform->m_changes = m_changes.get();
+            xform->m_node = i;
+
+            if (moved || xform->needs_update()) {
+                m_changes->push_back(i);
+            }
+        }
+
+        if (RectTransform* rect = rects ? rects->get(index) : nullptr) {
+            rect->m_changes = m_rect_changes.get();
+            rect->m_node = i;
+
+            if (moved || rect->needs_update()) {
+                m_rect_changes->push_back(i);
+            }
+        }
+    }
+
+    m_built = std::move(built);
+}
+
+void TransformHierarchy::update(World& world, std::uint64_t links_version)
+{
+    auto transforms = world.get_component_storage<Transform>();
+    auto rects = world.get_component_storage<RectTransform>();
+    std::tuple versions {
+        links_version,
+        transforms ? transforms->version() : 0,
+        rects ? rects->version() : 0,
+    };
+
+    if (versions != m_versions) {
+        rebuild(world);
+        m_versions = versions;
+    }
+}
+
+void TransformHierarchy::propagate(World& world)
+{
+    auto transforms = world.get_component_storage<Transform>();
+    auto& changes = *m_changes;
+
+    m_updated_bounds.clear();
+
+    if (!transforms || changes.empty()) {
+        return;
+    }
+
+    // parents come first, and a change already updates the whole subtree
+    std::sort(changes.begin(), changes.end());
+
+    std::size_t total = 0;
+    std::size_t updated_end = 0;
+
+    m_subtrees.clear();
+
+    for (std::size_t changed : changes) {
+        if (changed < updated_end) {
+            continue;
+        }
+
+        updated_end = m_nodes[changed].subtree_end;
+        m_subtrees.push_back({ changed, updated_end });
+        total += updated_end - changed;
+    }
+
+    changes.clear();
+
+    // subtrees are disjoint, and only read parents outside of any of them: they
+    // can be updated in parallel, with the same results
+    std::size_t threads = 1;
+    ThreadPool* pool = nullptr;
+
+    // the pool is only started once it is worth it, small scenes never pay
+    // for its threads
+    if (total >= PARALLEL_THRESHOLD && m_subtrees.size() > 1) {
+        pool = &world.get_or_emplace<ThreadPool>();
+        threads = std::min(pool->size(), m_subtrees.size());
+    }
+
+    // split subtrees in groups of roughly the same number of nodes
+    m_groups.clear();
+
+    std::size_t group_start = 0;
+    std::size_t group_nodes = 0;
+
+    for (std::size_t i = 0; i < m_subtrees.size(); i++) {
+        group_nodes += m_subtrees[i].end - m_subtrees[i].first;
+
+        if (group_nodes * threads >= total * (m_groups.size() + 1)
+            || i + 1 == m_subtrees.size()) {
+            m_groups.push_back({ group_start, i + 1 });
+            group_start = i + 1;
+        }
+    }
+
+    if (m_batches.size() < m_groups.size()) {
+        m_batches.resize(m_groups.size());
+    }
+
+    auto bounds = world.get_component_storage<WorldBounds>();
+
+    auto update_group = [&](std::size_t group) {
+        const Range& subtrees = m_groups[group];
+
+        m_batches[group].updated_bounds.clear();
+
+        for (std::size_t i = subtrees.first; i < subtrees.end; i++) {
+            update_subtree(
+                *transforms, bounds, m_subtrees[i], m_batches[group]);
+        }
+    };
+
+    if (m_groups.size() == 1) {
+        update_group(0);
+    } else {
+        pool->for_each(m_groups.size(), update_group);
+    }
+
+    for (std::size_t group = 0; group < m_groups.size(); group++) {
+        const auto& updated = m_batches[group].updated_bounds;
+
+        m_updated_bounds.insert(
+            m_updated_bounds.end(), updated.begin(), updated.end());
+    }
+}
+
+void TransformHierarchy::update_subtree(
+    Transform::Storage& transforms, StorageOf<WorldBounds>* bounds,
+    Range subtree, Batch& batch) const
+{
+    std::size_t first = subtree.first;
+    std::size_t count = subtree.end - first;
+
+    batch.resize(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        Transform* xform = transforms.get(m_nodes[first + i].entity.index());
+
+        batch.xforms[i] = xform;
+
+        if (xform) {
+            batch.translations[i] = xform->m_translation;
+            batch.rotations[i] = xform->m_rotation;
+            batch.scales[i] = xform->m_scale;
+        } else {
+            batch.translations[i] = glm::vec3(0.0f);
+            batch.rotations[i] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+            batch.scales[i] = glm::vec3(1.0f);
+        }
+    }
+
+    // local matrices of the whole subtree at once
+    Affine::from_trs(
+        batch.translations, batch.rotations, batch.scales, batch.locals);
+
+    for (std::size_t i = 0; i < count; i++) {
+        const Node& node = m_nodes[first + i];
+        std::size_t parent = node.parent;
+        Affine& world = batch.locals[i];
+
+        if (!batch.xforms[i]) {
+            continue;
+        }
+
+        // children of nodes without a transform are updated like roots
+        if (parent == NO_PARENT) {
+            // roots: the world transform is the local one
+        } else if (parent >= first) {
+            if (batch.xforms[parent - first]) {
+                world = batch.locals[parent - first] * world;
+            }
+        } else if (
+            auto xform = transforms.get(m_nodes[parent].entity.index())) {
+            world = Affine::from_mat4(xform->local_to_world()) * world;
+        }
+
+        batch.xforms[i]->set_world(world);
+
+        if (bounds) {
+            if (auto node_bounds = bounds->get(node.entity.index())) {
+                node_bounds->force_update(batch.xforms[i]->local_to_world());
+                batch.updated_bounds.push_back(node.entity);
+            }
+        }
+    }
+}
+
+void TransformHierarchy::layout(World& world, vec2 root_size)
+{
+    auto rects = world.get_component_storage<RectTransform>();
+    auto& changes = *m_rect_changes;
+
+    if (!rects) {
+        return;
+    }
+
+    // everything is anchored to the root rectangle in the end
+    if (root_size != m_root_size) {
+        m_root_size = root_size;
+        changes.clear();
+
+        for (std::size_t i = 0; i < m_nodes.size(); i++) {
+            if (m_nodes[i].parent == NO_PARENT) {
+                changes.push_back(i);
+            }
+        }
+    }
+
+    if (changes.empty()) {
+        return;
+    }
+
+    std::sort(changes.begin(), changes.end());
+
+    std::size_t updated_end = 0;
+
+    for (std::size_t changed : changes) {
+        if (changed < updated_end) {
+            continue;
+        }
+
+        updated_end = m_nodes[changed].subtree_end;
+
+        for (std::size_t i = changed; i < updated_end; i++) {
+            const Node& node = m_nodes[i];
+            RectTransform* rect = rects->get(node.entity.index());
+
+            if (!rect) {
+                continue;
+            }
+
+            const RectTransform* parent = nullptr;
+
+            if (node.parent != NO_PARENT) {
+                parent = rects->get(m_nodes[node.parent].entity.index());
+            }
+
+            if (parent) {
+                rect->force_update(
+                    parent->abs_bounds_min(), parent->abs_bounds_max(),
+                    parent->abs_depth() - 0.1f);
+            } else {
+                rect->force_update(vec2(0.0f), root_size, 0.0f);
+            }
+        }
+    }
+
+    changes.clear();
+}
+
+void TransformHierarchy::Batch::resize(std::size_t count)
+{
+    xforms.resize(count);
+    translations.resize(count);
+    rotations.resize(count);
+    scales.resize(count);
+    locals.resize(count);
+}
+
+const std::vector<TransformHierarchy::Node>& TransformHierarchy::nodes() const
+{
+    return m_nodes;
+}
+
+std::uint64_t TransformHierarchy::version() const
+{
+    return m_version;
+}
+
+const std::vector<EntityId>& TransformHierarchy::updated_bounds() const
+{
+    return m_updated_bounds;
+}
+
+std::optional<std::size_t> TransformHierarchy::node_of(EntityId entity) const
+{
+    std::size_t index = entity.index();
+
+    if (index < m_built.size() && m_built[index]
+        && m_built[index]->entity == entity) {
+        return m_built[index]->node;
+    } else {
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,170 @@
+#ifndef EBD039CE_DD76_448C_B2AC_785AE5D60821
+#define EBD039CE_DD76_448C_B2AC_785AE5D60821
+
+#include "igepch.hpp"
+
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Entities with a `Transform`, a `RectTransform` or with children,
+ * flattened in depth-first order.
+ *
+ * Parents always come before their children, and every node knows the index
+ * of its parent node, so that subtrees are contiguous. `Transform` and
+ * `RectTransform` setters report their node when they become dirty, and only
+ * the subtrees of these nodes are visited when computing world transforms or
+ * laying out rects.
+ *
+ * Nodes without a `Transform` are kept so that other hierarchical properties
+ * (e.g. visibility) can be propagated over the same nodes. For transforms,
+ * they act as a boundary: their children with a `Transform` are updated as
+ * if they were roots. The same goes for rects, which are laid out relative to
+ * the window when their parent isn't a rect.
+ */
+class TransformHierarchy {
+public:
+    static constexpr std::size_t NO_PARENT
+        = std::numeric_limits<std::size_t>::max();
+
+    struct Node {
+        ige::ecs::EntityId entity;
+
+        // index of the parent node, or NO_PARENT for roots
+        std::size_t parent;
+
+        // index following the last node of the subtree
+        std::size_t subtree_end;
+    };
+
+    /**
+     * @brief Flatten the hierarchy described by the `Children` components.
+     *
+     * Nodes that weren't in the hierarchy before, or whose parent changed,
+     * get their world transform updated by the next `propagate`.
+     */
+    void rebuild(ige::ecs::World&);
+
+    /**
+     * @brief Rebuild the hierarchy only if the parenting (as given by
+     * `links_version`) or the set of entities with a `Transform` or a
+     * `RectTransform` changed since the last rebuild.
+     */
+    void update(ige::ecs::World&, std::uint64_t links_version);
+
+    /**
+     * @brief Update the world transform (and `WorldBounds`) of every node that
+     * changed (or whose parent changed).
+     *
+     * Only the subtrees of changed nodes are visited. When there are enough
+     * of them, they are spread across the `ThreadPool` resource, which is
+     * created the first time it is needed.
+     */
+    void propagate(ige::ecs::World&);
+
+    /**
+     * @brief Lay out every rect that changed (or whose parent changed).
+     *
+     * Root rects are laid out in a `(0, 0)`-`root_size` rectangle (i.e. the
+     * window): when it changes, all rects are laid out again.
+     */
+    void layout(ige::ecs::World&, glm::vec2 root_size);
+
+    const std::vector<Node>& nodes() const;
+
+    /**
+     * @brief Number of times the hierarchy was rebuilt.
+     */
+    std::uint64_t version() const;
+
+    /**
+     * @brief Entities whose `WorldBounds` were updated by the last
+     * `propagate`.
+     */
+    const std::vector<ige::ecs::EntityId>& updated_bounds() const;
+
+    /**
+     * @brief Index of the node of the given entity, if it was in the hierarchy
+     * during the last rebuild.
+     */
+    std::optional<std::size_t> node_of(ige::ecs::EntityId) const;
+
+private:
+    // below this many nodes to update, waking up workers costs more than it
+    // saves
+    static constexpr std::size_t PARALLEL_THRESHOLD = 1024;
+
+    struct Range {
+        std::size_t first;
+        std::size_t end;
+    };
+
+    // transforms of a subtree, updated together
+    struct Batch {
+        std::vector<ige::plugin::transform::Transform*> xforms;
+        std::vector<glm::vec3> translations;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> scales;
+
+        // local matrices, then world matrices once combined with the parents
+        std::vector<ige::plugin::transform::Affine> locals;
+
+        // entities whose bounds were updated, across all subtrees
+        std::vector<ige::ecs::EntityId> updated_bounds;
+
+        void resize(std::size_t);
+    };
+
+    struct Built {
+        ige::ecs::EntityId entity;
+        std::optional<ige::ecs::EntityId> parent;
+        std::size_t node;
+    };
+
+    std::vector<Node> m_nodes;
+    std::uint64_t m_version = 0;
+
+    // node of each entity during the last rebuild, by entity index
+    std::vector<std::optional<Built>> m_built;
+
+    // nodes whose subtree must be updated, pushed by `Transform` setters
+    // (heap allocated so transforms can point to it even if we are moved)
+    std::unique_ptr<std::vector<std::size_t>> m_changes
+        = std::make_unique<std::vector<std::size_t>>();
+
+    // same for `RectTransform`
+    std::unique_ptr<std::vector<std::size_t>> m_rect_changes
+        = std::make_unique<std::vector<std::size_t>>();
+
+    // size of the rectangle root rects were last laid out in
+    std::optional<glm::vec2> m_root_size;
+
+    // changed subtrees (ranges of nodes), and groups of them (ranges of
+    // subtrees) updated by the same thread, each with its own batch
+    std::vector<Range> m_subtrees;
+    std::vector<Range> m_groups;
+    std::vector<Batch> m_batches;
+    std::vector<ige::ecs::EntityId> m_updated_bounds;
+
+    // links, transforms and rects versions of the last rebuild
+    std::optional<std::tuple<std::uint64_t, std::uint64_t, std::uint64_t>>
+        m_versions;
+
+    // `bounds` can be null when no entity has `WorldBounds`
+    void update_subtree(
+        ige::plugin::transform::Transform::Storage&,
+        ige::ecs::StorageOf<ige::plugin::transform::WorldBounds>* bounds,
+        Range subtree, Batch&) const;
+};
+
+#endif /* EBD039CE_DD76_448C_B2AC_785AE5D60821 */
@@ -0,0 +1,51 @@
+#include "igepch.hpp"
+
+#include "ige/core/Bounds.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+
+using glm::mat4;
+using ige::asset::Mesh;
+using ige::core::Aabb;
+using ige::core::BoundingSphere;
+using ige::plugin::transform::WorldBounds;
+
+WorldBounds::WorldBounds(
+    Aabb local_aabb, BoundingSphere local_sphere, const Mesh* mesh)
+    : m_local_aabb(local_aabb)
+    , m_local_sphere(local_sphere)
+    , m_aabb(local_aabb)
+    , m_sphere(local_sphere)
+    , m_mesh(mesh)
+{
+}
+
+const Aabb& WorldBounds::local_aabb() const
+{
+    return m_local_aabb;
+}
+
+const BoundingSphere& WorldBounds::local_sphere() const
+{
+    return m_local_sphere;
+}
+
+const Mesh* WorldBounds::mesh() const
+{
+    return m_mesh;
+}
+
+const Aabb& WorldBounds::aabb() const
+{
+    return m_aabb;
+}
+
+const BoundingSphere& WorldBounds::sphere() const
+{
+    return m_sphere;
+}
+
+void WorldBounds::force_update(const mat4& local_to_world)
+{
+    m_aabb = m_local_aabb.transformed(local_to_world);
+    m_sphere = m_local_sphere.transformed(local_to_world);
+}
@@ -0,0 +1,262 @@
+#include "igepch.hpp"
+
+#include "EglPbuffer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <dlfcn.h>
+#endif
+
+#ifdef __linux__
+
+// entry points of the libEGL loaded at runtime
+struct EglPbuffer::Egl {
+    void* library = nullptr;
+
+    PFNEGLGETPROCADDRESSPROC GetProcAddress = nullptr;
+    PFNEGLQUERYSTRINGPROC QueryString = nullptr;
+    PFNEGLGETDISPLAYPROC GetDisplay = nullptr;
+    PFNEGLINITIALIZEPROC Initialize = nullptr;
+    PFNEGLTERMINATEPROC Terminate = nullptr;
+    PFNEGLBINDAPIPROC BindAPI = nullptr;
+    PFNEGLCHOOSECONFIGPROC ChooseConfig = nullptr;
+    PFNEGLCREATEPBUFFERSURFACEPROC CreatePbufferSurface = nullptr;
+    PFNEGLDESTROYSURFACEPROC DestroySurface = nullptr;
+    PFNEGLCREATECONTEXTPROC CreateContext = nullptr;
+    PFNEGLDESTROYCONTEXTPROC DestroyContext = nullptr;
+    PFNEGLMAKECURRENTPROC MakeCurrent = nullptr;
+    PFNEGLGETCURRENTCONTEXTPROC GetCurrentContext = nullptr;
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLContext context = EGL_NO_CONTEXT;
+
+    ~Egl()
+    {
+        if (context != EGL_NO_CONTEXT) {
+            DestroyContext(display, context);
+        }
+
+        if (surface != EGL_NO_SURFACE) {
+            DestroySurface(display, surface);
+        }
+
+        if (display != EGL_NO_DISPLAY) {
+            Terminate(display);
+        }
+
+        if (library) {
+            dlclose(library);
+        }
+    }
+};
+
+template <typename F>
+static void load(void* library, F& function, const char* name)
+{
+    function = reinterpret_cast<F>(dlsym(library, name));
+
+    if (!function) {
+        throw std::runtime_error(std::string("libEGL lacks ") + name);
+    }
+}
+
+static bool has_extension(const char* extensions, const char* name)
+{
+    std::size_t length = std::strlen(name);
+
+    for (const char* it = extensions; it && (it = std::strstr(it, name));
+         it += length) {
+        bool starts = it == extensions || it[-1] == ' ';
+        bool ends = it[length] == ' ' || it[length] == '\0';
+
+        if (starts && ends) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+EglPbuffer::EglPbuffer(std::uint32_t width, std::uint32_t height)
+    : m_egl(std::make_unique<Egl>())
+{
+    Egl& egl = *m_egl;
+
+    egl.library = dlopen("libEGL.so.1", RTLD_LAZY | RTLD_LOCAL);
+
+    if (!egl.library) {
+        throw std::runtime_error("libEGL.so.1 not found");
+    }
+
+    load(egl.library, egl.GetProcAddress, "eglGetProcAddress");
+    load(egl.library, egl.QueryString, "eglQueryString");
+    load(egl.library, egl.GetDisplay, "eglGetDisplay");
+    load(egl.library, egl.Initialize, "eglInitialize");
+    load(egl.library, egl.Terminate, "eglTerminate");
+    load(egl.library, egl.BindAPI, "eglBindAPI");
+    load(egl.library, egl.ChooseConfig, "eglChooseConfig");
+    load(egl.library, egl.CreatePbufferSurface, "eglCreatePbufferSurface");
+    load(egl.library, egl.DestroySurface, "eglDestroySurface");
+    load(egl.library, egl.CreateContext, "eglCreateContext");
+    load(egl.library, egl.DestroyContext, "eglDestroyContext");
+    load(egl.library, egl.MakeCurrent, "eglMakeCurrent");
+    load(egl.library, egl.GetCurrentContext, "eglGetCurrentContext");
+
+    // the surfaceless platform doesn't need any device or display server,
+    // the default display may try to connect to one
+    const char* client_extensions
+        = egl.QueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (has_extension(client_extensions, "EGL_MESA_platform_surfaceless")
+        && has_extension(client_extensions, "EGL_EXT_platform_base")) {
+        auto get_platform_display
+            = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                egl.GetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (get_platform_display) {
+            egl.display = get_platform_display(
+                EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+    }
+
+    if (egl.display == EGL_NO_DISPLAY) {
+        egl.display = egl.GetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    if (egl.display == EGL_NO_DISPLAY
+        || !egl.Initialize(egl.display, nullptr, nullptr)) {
+        egl.display = EGL_NO_DISPLAY;
+        throw std::runtime_error("no EGL display");
+    }
+
+    if (!egl.BindAPI(EGL_OPENGL_API)) {
+        throw std::runtime_error("EGL doesn't support desktop OpenGL");
+    }
+
+    // same default framebuffer as the windows created by GLFW
+    const EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE,
+        EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,
+        EGL_OPENGL_BIT,
+        EGL_RED_SIZE,
+        8,
+        EGL_GREEN_SIZE,
+        8,
+        EGL_BLUE_SIZE,
+        8,
+        EGL_ALPHA_SIZE,
+        8,
+        EGL_DEPTH_SIZE,
+        24,
+        EGL_STENCIL_SIZE,
+        8,
+        EGL_NONE,
+    };
+
+    EGLConfig config;
+    EGLint config_count = 0;
+
+    if (!egl.ChooseConfig(
+            egl.display, config_attribs, &config, 1, &config_count)
+        || config_count == 0) {
+        throw std::runtime_error("no EGL config with an OpenGL pbuffer");
+    }
+
+    const EGLint surface_attribs[] = {
+        EGL_WIDTH,
+        static_cast<EGLint>(width),
+        EGL_HEIGHT,
+        static_cast<EGLint>(height),
+        EGL_NONE,
+    };
+
+    egl.surface
+        = egl.CreatePbufferSurface(egl.display, config, surface_attribs);
+
+    if (egl.surface == EGL_NO_SURFACE) {
+        throw std::runtime_error("unable to create an EGL pbuffer");
+    }
+
+    const EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION,
+        4,
+        EGL_CONTEXT_MINOR_VERSION,
+        1,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK,
+        EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE,
+    };
+
+    egl.context = egl.CreateContext(
+        egl.display, config, EGL_NO_CONTEXT, context_attribs);
+
+    if (egl.context == EGL_NO_CONTEXT) {
+        throw std::runtime_error("unable to create an OpenGL 4.1 EGL context");
+    }
+}
+
+void EglPbuffer::make_current()
+{
+    Egl& egl = *m_egl;
+
+    // the bound API is per thread
+    egl.BindAPI(EGL_OPENGL_API);
+
+    if (egl.GetCurrentContext() != egl.context) {
+        egl.MakeCurrent(egl.display, egl.surface, egl.surface, egl.context);
+    }
+}
+
+void EglPbuffer::release()
+{
+    Egl& egl = *m_egl;
+
+    egl.BindAPI(EGL_OPENGL_API);
+
+    if (egl.GetCurrentContext() == egl.context) {
+        egl.MakeCurrent(
+            egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+EglPbuffer::Proc EglPbuffer::proc_address(const char* name) const
+{
+    return m_egl->GetProcAddress(name);
+}
+
+#else
+
+struct EglPbuffer::Egl {
+};
+
+EglPbuffer::EglPbuffer(std::uint32_t, std::uint32_t)
+{
+    throw std::runtime_error("EGL pbuffers are only supported on Linux");
+}
+
+void EglPbuffer::make_current()
+{
+}
+
+void EglPbuffer::release()
+{
+}
+
+EglPbuffer::Proc EglPbuffer::proc_address(const char*) const
+{
+    return nullptr;
+}
+
+#endif
+
+EglPbuffer::EglPbuffer(EglPbuffer&&) = default;
+EglPbuffer& EglPbuffer::operator=(EglPbuffer&&) = default;
+EglPbuffer::~EglPbuffer() = default;
@@ -0,0 +1,54 @@
+#ifndef F60504A8_B75E_4C6F_BA57_456CD3F8795B
+#define F60504A8_B75E_4C6F_BA57_456CD3F8795B
+
+#include "igepch.hpp"
+
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief OpenGL 4.1 core context rendering to an EGL pbuffer, without a
+ * display server.
+ *
+ * The pbuffer is the default framebuffer of the context, and keeps the size it
+ * was created with. libEGL is loaded at runtime, and the Mesa surfaceless
+ * platform is preferred when available. Only supported on Linux.
+ */
+class EglPbuffer {
+public:
+    using Proc = void (*)();
+
+    /**
+     * @brief Create the context and its pbuffer.
+     *
+     * Throws a `std::runtime_error` saying what is missing when EGL can't
+     * provide them.
+     */
+    EglPbuffer(std::uint32_t width, std::uint32_t height);
+    EglPbuffer(EglPbuffer&&);
+    EglPbuffer& operator=(EglPbuffer&&);
+    ~EglPbuffer();
+
+    /**
+     * @brief Make the context current on the calling thread, unless it
+     * already is.
+     */
+    void make_current();
+
+    /**
+     * @brief Release the context from the calling thread, if it is current.
+     */
+    void release();
+
+    /**
+     * @brief Address of an OpenGL function, to load them with glad.
+     */
+    Proc proc_address(const char* name) const;
+
+private:
+    struct Egl;
+
+    std::unique_ptr<Egl> m_egl;
+};
+
+#endif /* F60504A8_B75E_4C6F_BA57_456CD3F8795B */
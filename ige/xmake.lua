@@ -2,12 +2,17 @@ add_requires(
     "glm ^0.9.9",
     "bullet3 ^3.09",
     "nlohmann_json ^3.9.1",
-    "glfw ^3.3.4",
+    "glfw ^3.4",
     "fx-gltf ^1.2.0"
 )
 add_requires("libvorbis ^1.3.7", {configs={with_vorbisenc=false}})
 add_requires("openal-soft ^1.21.1", {configs={shared=true}})
 
+-- headless contexts load libEGL at runtime
+if is_plat("linux") then
+    add_requires("egl-headers")
+end
+
 target("glad")
     set_kind("object")
     add_files("glad/src/**.c")
@@ -62,6 +67,11 @@ target("ige")
         {public=true}
     )
 
+    if is_plat("linux") then
+        add_packages("egl-headers")
+        add_syslinks("dl")
+    end
+
 rule("embed_bytes")
     before_build(function(target, opt)
         import("core.base.option")
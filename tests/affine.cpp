@@ -0,0 +1,107 @@
+#include "ige/plugin/transform/Affine.hpp"
+#include "gtest/gtest.h"
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <vector>
+
+using glm::mat4;
+using glm::quat;
+using glm::vec3;
+using ige::plugin::transform::Affine;
+
+struct Trs {
+    vec3 translation;
+    quat rotation;
+    vec3 scale;
+};
+
+static std::vector<Trs> make_trs(int count)
+{
+    std::vector<Trs> trs;
+
+    for (int i = 0; i < count; i++) {
+        float f = static_cast<float>(i);
+
+        trs.push_back({
+            vec3(f, -2.0f * f, 0.5f + f),
+            glm::angleAxis(0.3f * f, glm::normalize(vec3(1.0f, f, 2.0f))),
+            vec3(1.0f + f, 2.0f, 0.5f + 0.1f * f),
+        });
+    }
+
+    return trs;
+}
+
+static mat4 glm_trs(const Trs& trs)
+{
+    mat4 m = glm::translate(mat4(1.0f), trs.translation)
+        * glm::mat4_cast(trs.rotation);
+
+    return glm::scale(m, trs.scale);
+}
+
+static void expect_mat4_near(const mat4& a, const mat4& b)
+{
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            EXPECT_NEAR(a[i][j], b[i][j], 1e-4f);
+        }
+    }
+}
+
+TEST(Affine, FromTrs)
+{
+    for (const Trs& trs : make_trs(5)) {
+        Affine affine
+            = Affine::from_trs(trs.translation, trs.rotation, trs.scale);
+
+        expect_mat4_near(affine.to_mat4(), glm_trs(trs));
+    }
+}
+
+TEST(Affine, InverseOfTrs)
+{
+    for (const Trs& trs : make_trs(5)) {
+        Affine affine
+            = Affine::from_trs(trs.translation, trs.rotation, trs.scale);
+
+        expect_mat4_near(
+            affine.inverse().to_mat4(), glm::inverse(glm_trs(trs)));
+    }
+}
+
+TEST(Affine, Batch)
+{
+    // not a multiple of the SIMD width
+    auto trs = make_trs(11);
+
+    std::vector<vec3> translations, scales;
+    std::vector<quat> rotations;
+
+    for (const Trs& t : trs) {
+        translations.push_back(t.translation);
+        rotations.push_back(t.rotation);
+        scales.push_back(t.scale);
+    }
+
+    std::vector<Affine> affines(trs.size());
+
+    Affine::from_trs(translations, rotations, scales, affines);
+
+    for (std::size_t i = 0; i < trs.size(); i++) {
+        expect_mat4_near(affines[i].to_mat4(), glm_trs(trs[i]));
+    }
+}
+
+TEST(Affine, MultiplyAndInverse)
+{
+    auto trs = make_trs(3);
+    mat4 a = glm_trs(trs[1]);
+    mat4 b = glm_trs(trs[2]);
+
+    Affine product = Affine::from_mat4(a) * Affine::from_mat4(b);
+
+    expect_mat4_near(product.to_mat4(), a * b);
+    expect_mat4_near(product.inverse().to_mat4(), glm::inverse(a * b));
+}
@@ -0,0 +1,111 @@
+#include "ige/core/App.hpp"
+#include "ige/core/State.hpp"
+#include "ige/ecs/System.hpp"
+#include "ige/ecs/World.hpp"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using ige::core::App;
+using ige::core::MainWorld;
+using ige::core::State;
+using ige::ecs::System;
+using ige::ecs::World;
+
+struct Frame {
+    int index = 0;
+};
+
+class QuitAfter : public State {
+public:
+    QuitAfter(int frames)
+        : m_frames(frames)
+    {
+    }
+
+    void on_update(App& app) override
+    {
+        if (--m_frames == 0) {
+            app.quit();
+        }
+    }
+
+private:
+    int m_frames;
+};
+
+static App::Builder make_app(std::vector<int>& rendered)
+{
+    return App::Builder()
+        .add_system(System::from(
+            [](World& world) { world.get_or_emplace<Frame>().index++; }))
+        .add_extract_system(System::from([](World& render_world) {
+            World& world = render_world.get<MainWorld>()->get();
+
+            render_world.insert(*world.get<Frame>());
+        }))
+        .add_render_system(System::from([&](World& render_world) {
+            rendered.push_back(render_world.get<Frame>()->index);
+        }));
+}
+
+TEST(App, SerialRender)
+{
+    std::vector<int> rendered;
+
+    make_app(rendered).run<QuitAfter>(5);
+
+    ASSERT_EQ(rendered, std::vector<int>({ 1, 2, 3, 4, 5, 6 }));
+}
+
+TEST(App, RenderStages)
+{
+    std::vector<int> stages;
+
+    // registered out of order, on purpose
+    App::Builder()
+        .add_present_system(
+            System::from([&](World&) { stages.push_back(3); }))
+        .add_render_system(System::from([&](World&) { stages.push_back(2); }))
+        .add_begin_frame_system(
+            System::from([&](World&) { stages.push_back(1); }))
+        .run<QuitAfter>(1);
+
+    ASSERT_EQ(stages, std::vector<int>({ 1, 2, 3, 1, 2, 3 }));
+}
+
+TEST(App, PipelinedRender)
+{
+    std::vector<int> rendered;
+
+    make_app(rendered).set_pipelined().run<QuitAfter>(5);
+
+    ASSERT_EQ(rendered, std::vector<int>({ 1, 2, 3, 4, 5, 6 }));
+}
+
+TEST(App, PipelinedRenderThread)
+{
+    std::thread::id main_thread = std::this_thread::get_id();
+    std::thread::id render_thread;
+    std::thread::id cleanup_thread;
+
+    App::Builder()
+        .set_pipelined()
+        .add_render_system(System::from(
+            [&](World&) { render_thread = std::this_thread::get_id(); }))
+        .add_render_cleanup_system(System::from(
+            [&](World&) { cleanup_thread = std::this_thread::get_id(); }))
+        .run<QuitAfter>(1);
+
+    ASSERT_NE(render_thread, main_thread);
+    ASSERT_EQ(cleanup_thread, render_thread);
+}
+
+TEST(App, PipelinedRenderError)
+{
+    auto app = App::Builder().set_pipelined().add_render_system(
+        System::from([](World&) { throw std::runtime_error("render"); }));
+
+    ASSERT_THROW(app.run<QuitAfter>(10), std::runtime_error);
+}
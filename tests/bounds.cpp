@@ -0,0 +1,159 @@
+#include "ige/asset/Mesh.hpp"
+#include "ige/core/Bounds.hpp"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <random>
+#include <vector>
+
+using glm::mat4;
+using glm::vec3;
+using glm::vec4;
+using ige::asset::Mesh;
+using ige::core::Aabb;
+using ige::core::BoundingSphere;
+using ige::core::Frustum;
+
+static void expect_near(vec3 actual, vec3 expected)
+{
+    EXPECT_NEAR(actual.x, expected.x, 1e-5f);
+    EXPECT_NEAR(actual.y, expected.y, 1e-5f);
+    EXPECT_NEAR(actual.z, expected.z, 1e-5f);
+}
+
+TEST(Bounds, AabbTranslated)
+{
+    Aabb box { { -1, -2, -3 }, { 1, 2, 3 } };
+    Aabb moved = box.transformed(glm::translate(mat4(1.0f), { 10, 0, -5 }));
+
+    expect_near(moved.min, { 9, -2, -8 });
+    expect_near(moved.max, { 11, 2, -2 });
+}
+
+TEST(Bounds, AabbRotated)
+{
+    Aabb box { { -1, -2, -3 }, { 1, 2, 3 } };
+    mat4 rotation
+        = glm::rotate(mat4(1.0f), glm::radians(90.0f), vec3 { 0, 1, 0 });
+    Aabb rotated = box.transformed(rotation);
+
+    // x and z swap places
+    expect_near(rotated.min, { -3, -2, -1 });
+    expect_near(rotated.max, { 3, 2, 1 });
+}
+
+TEST(Bounds, SphereScaled)
+{
+    BoundingSphere sphere { { 1, 0, 0 }, 2.0f };
+    BoundingSphere scaled
+        = sphere.transformed(glm::scale(mat4(1.0f), { 1, 3, 2 }));
+
+    expect_near(scaled.center, { 1, 0, 0 });
+    EXPECT_NEAR(scaled.radius, 6.0f, 1e-5f);
+}
+
+TEST(Bounds, SphereScreenRect)
+{
+    mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 50.0f);
+    BoundingSphere sphere { { 0, 0, -10 }, 1.0f };
+    vec4 rect = sphere.screen_rect(projection);
+
+    // the exact projection spans tan(asin(1 / 10)) on each side
+    float extent = 0.1f / glm::sqrt(0.99f);
+
+    EXPECT_LE(rect.x, -extent);
+    EXPECT_LE(rect.y, -extent);
+    EXPECT_GE(rect.z, extent);
+    EXPECT_GE(rect.w, extent);
+    EXPECT_GT(rect.x, -0.2f);
+    EXPECT_LT(rect.z, 0.2f);
+}
+
+TEST(Bounds, SphereScreenRectClamped)
+{
+    mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 50.0f);
+
+    BoundingSphere right { { 10, 0, -10 }, 2.0f };
+    BoundingSphere around { { 0, 0, 0 }, 2.0f };
+
+    // partly off screen
+    vec4 rect = right.screen_rect(projection);
+
+    EXPECT_GT(rect.x, 0.5f);
+    EXPECT_EQ(rect.z, 1.0f);
+
+    // reaches behind the camera
+    rect = around.screen_rect(projection);
+
+    EXPECT_EQ(rect, vec4(-1.0f, -1.0f, 1.0f, 1.0f));
+}
+
+TEST(Bounds, CubeMesh)
+{
+    Mesh cube = Mesh::cube(2.0f);
+
+    EXPECT_EQ(cube.bounds().min, vec3(-1.0f));
+    EXPECT_EQ(cube.bounds().max, vec3(1.0f));
+    EXPECT_EQ(cube.bounding_sphere().center, vec3(0.0f));
+    EXPECT_NEAR(cube.bounding_sphere().radius, glm::sqrt(3.0f), 1e-5f);
+}
+
+TEST(Bounds, OnlyIndexedVertices)
+{
+    float positions[] = {
+        0, 0, 0, 0, //
+        1, 0, 0, 0, //
+        0, 1, 0, 0, //
+        9, 9, 9, 0, // not indexed
+    };
+    std::uint32_t indices[] = { 0, 1, 2 };
+
+    Mesh::Builder builder;
+    builder.set_index_buffer(indices);
+    builder.add_buffer<float>(positions);
+    builder.attr_position({ 0, 0, sizeof(float) * 4 });
+    builder.attr_normal({ 0, 0, sizeof(float) * 4 });
+
+    Mesh mesh = builder.build();
+
+    EXPECT_EQ(mesh.bounds().min, vec3(0.0f));
+    EXPECT_EQ(mesh.bounds().max, vec3(1.0f, 1.0f, 0.0f));
+}
+
+TEST(Bounds, FrustumCull)
+{
+    Frustum frustum = Frustum::from_matrix(
+        glm::perspective(glm::radians(70.0f), 1.5f, 0.1f, 50.0f)
+        * glm::lookAt(vec3(5, 2, 5), vec3(0), vec3(0, 1, 0)));
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    // not a multiple of the batch size
+    std::vector<Aabb> boxes(1003);
+
+    for (auto& box : boxes) {
+        box.min = { position(rng), position(rng), position(rng) };
+        box.max = box.min + vec3(size(rng), size(rng), size(rng));
+    }
+
+    std::vector<std::uint8_t> visible(boxes.size());
+    std::size_t count = frustum.cull(boxes, visible);
+    std::size_t expected = 0;
+
+    for (std::size_t i = 0; i < boxes.size(); i++) {
+        bool inside = frustum.intersects(boxes[i]);
+
+        EXPECT_EQ(visible[i] != 0, inside) << "box " << i;
+        expected += inside;
+    }
+
+    EXPECT_EQ(count, expected);
+    EXPECT_GT(count, 0);
+    EXPECT_LT(count, boxes.size());
+}
@@ -1,5 +1,7 @@
 #include "ige/core/EventChannel.hpp"
 #include "gtest/gtest.h"
+#include <numeric>
+#include <vector>
 
 using ige::core::EventChannel;
 
@@ -103,3 +105,111 @@ TEST(EventChannel, SubscriberNeverPolls)
         ASSERT_FALSE(poller.next_event() != nullptr);
     }
 }
+
+TEST(EventChannel, WrapAround)
+{
+    EventChannel<int> channel;
+
+    EventChannel<int>::Subscription sub = channel.subscribe();
+
+    for (int i = 0; i < 1000; i++) {
+        channel.push(i);
+        channel.push(i + 1);
+        ASSERT_EQ(*sub.next_event(), i);
+        ASSERT_EQ(*sub.next_event(), i + 1);
+        ASSERT_FALSE(sub.next_event() != nullptr);
+    }
+}
+
+TEST(EventChannel, GrowWithSlowSubscriber)
+{
+    EventChannel<int> channel;
+
+    EventChannel<int>::Subscription fast = channel.subscribe();
+    EventChannel<int>::Subscription slow = channel.subscribe();
+
+    for (int i = 0; i < 100; i++) {
+        channel.push(i);
+        ASSERT_EQ(*fast.next_event(), i);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(*slow.next_event(), i);
+    }
+    ASSERT_FALSE(slow.next_event() != nullptr);
+}
+
+TEST(EventChannel, MoveSubscription)
+{
+    EventChannel<int> channel;
+
+    EventChannel<int>::Subscription sub = channel.subscribe();
+    channel.push(1);
+
+    EventChannel<int>::Subscription moved = std::move(sub);
+    channel.push(2);
+    ASSERT_EQ(*moved.next_event(), 1);
+    ASSERT_EQ(*moved.next_event(), 2);
+
+    sub = channel.subscribe();
+    channel.push(3);
+    ASSERT_EQ(*sub.next_event(), 3);
+    ASSERT_EQ(*moved.next_event(), 3);
+}
+
+TEST(EventChannel, Drain)
+{
+    EventChannel<int> channel;
+
+    EventChannel<int>::Subscription sub = channel.subscribe();
+
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 7; i++) {
+            channel.push(round * 7 + i);
+        }
+
+        std::vector<int> events;
+        for (auto batch : sub.drain()) {
+            events.insert(events.end(), batch.begin(), batch.end());
+        }
+
+        ASSERT_EQ(events.size(), 7);
+        for (int i = 0; i < 7; i++) {
+            ASSERT_EQ(events[i], round * 7 + i);
+        }
+        ASSERT_FALSE(sub.next_event() != nullptr);
+    }
+}
+
+TEST(EventChannel, PushBatch)
+{
+    EventChannel<int> channel;
+
+    EventChannel<int>::Subscription sub = channel.subscribe();
+    std::vector<int> events(100);
+    std::iota(events.begin(), events.end(), 0);
+
+    channel.push(-1);
+    channel.push_batch(events);
+
+    ASSERT_EQ(*sub.next_event(), -1);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(*sub.next_event(), i);
+    }
+    ASSERT_FALSE(sub.next_event() != nullptr);
+}
+
+TEST(EventChannel, MoveChannel)
+{
+    EventChannel<int> channel;
+
+    EventChannel<int>::Subscription sub = channel.subscribe();
+    channel.push(1);
+
+    EventChannel<int> moved = std::move(channel);
+    moved.push(2);
+
+    ASSERT_EQ(*sub.next_event(), 1);
+    ASSERT_EQ(*sub.next_event(), 2);
+    ASSERT_FALSE(sub.next_event() != nullptr);
+}
@@ -0,0 +1,258 @@
+#include "ige/asset/Material.hpp"
+#include "ige/asset/Mesh.hpp"
+#include "ige/asset/Skeleton.hpp"
+#include "ige/core/App.hpp"
+#include "ige/core/State.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/AnimationPlugin.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "ige/plugin/WindowPlugin.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+using glm::mat4;
+using glm::vec3;
+using glm::vec4;
+using ige::asset::Material;
+using ige::asset::Mesh;
+using ige::asset::Skeleton;
+using ige::core::App;
+using ige::core::State;
+using ige::ecs::World;
+using ige::plugin::animation::SkeletonPose;
+using ige::plugin::render::FrameReadback;
+using ige::plugin::render::Light;
+using ige::plugin::render::LightPassOptions;
+using ige::plugin::render::MeshRenderer;
+using ige::plugin::render::PerspectiveCamera;
+using ige::plugin::render::RenderPlugin;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::TransformPlugin;
+using ige::plugin::window::HeadlessContextError;
+using ige::plugin::window::WindowPlugin;
+using ige::plugin::window::WindowSettings;
+
+const std::uint32_t WIDTH = 64;
+const std::uint32_t HEIGHT = 48;
+
+using Setup = std::function<void(App&)>;
+
+// draws one frame of a scene looking at the origin, and reads it back
+class Capture : public State {
+public:
+    Capture(Setup setup, FrameReadback& frame)
+        : m_setup(std::move(setup))
+        , m_frame(frame)
+    {
+    }
+
+    void on_start(App& app) override
+    {
+        app.world().create_entity(
+            Transform::from_pos(vec3(0.0f, 0.0f, 3.0f)).look_at(vec3(0.0f)),
+            PerspectiveCamera(60.0f));
+
+        m_setup(app);
+        app.render_world().insert(FrameReadback {});
+    }
+
+    void on_update(App& app) override
+    {
+        // the first frame was read back at the end of the last update
+        if (m_updates++ == 1) {
+            m_frame = *app.render_world().get<FrameReadback>();
+            app.quit();
+        }
+    }
+
+private:
+    Setup m_setup;
+    FrameReadback& m_frame;
+    int m_updates = 0;
+};
+
+// skips the test when no headless context can be created
+static void render(FrameReadback& frame, Setup setup)
+{
+    try {
+        App::Builder()
+            .insert(WindowSettings {
+                .title = "headless",
+                .width = WIDTH,
+                .height = HEIGHT,
+                .headless = true,
+            })
+            .add_plugin(TransformPlugin {})
+            .add_plugin(WindowPlugin {})
+            .add_plugin(RenderPlugin {})
+            .run<Capture>(std::move(setup), frame);
+    } catch (const HeadlessContextError& e) {
+        // machines without EGL nor OSMesa can't run it, unless told they must
+        if (std::getenv("IGE_REQUIRE_HEADLESS")) {
+            FAIL() << e.what();
+        }
+
+        GTEST_SKIP() << e.what();
+    }
+
+    ASSERT_EQ(frame.width, WIDTH);
+    ASSERT_EQ(frame.height, HEIGHT);
+    ASSERT_EQ(frame.pixels.size(), WIDTH * HEIGHT * 4);
+
+    // release builds don't check for errors while drawing
+    EXPECT_EQ(frame.gl_errors, std::vector<std::string> {});
+}
+
+static vec3 pixel(const FrameReadback& frame, std::size_t x, std::size_t y)
+{
+    const std::uint8_t* rgba = &frame.pixels[(y * frame.width + x) * 4];
+
+    return vec3(rgba[0], rgba[1], rgba[2]);
+}
+
+static void expect_color(const FrameReadback& frame, vec3 center)
+{
+    vec3 actual = pixel(frame, WIDTH / 2, HEIGHT / 2);
+
+    EXPECT_NEAR(actual.x, center.x, 2.0f);
+    EXPECT_NEAR(actual.y, center.y, 2.0f);
+    EXPECT_NEAR(actual.z, center.z, 2.0f);
+    EXPECT_EQ(pixel(frame, 0, 0), vec3(0.0f));
+}
+
+static Material::Handle orange()
+{
+    auto material = Material::make_default();
+    material->set("base_color_factor", vec4 { 1.0f, 0.5f, 0.25f, 1.0f });
+
+    return material;
+}
+
+// a cube with a single joint, bound to the identity
+static Mesh::Handle skinned_cube(float size)
+{
+    Mesh cube = Mesh::cube(size);
+    Mesh::Attribute position = cube.attr_position();
+    std::size_t vertices = cube.buffers()[0].size() / position.stride;
+
+    std::vector<std::array<std::uint8_t, 4>> joints(vertices);
+    std::vector<vec4> weights(vertices, vec4(1.0f, 0.0f, 0.0f, 0.0f));
+
+    Mesh::Builder builder;
+    builder.set_topology(cube.topology());
+    builder.set_index_buffer(cube.index_buffer());
+    builder.add_buffer(std::span<const std::byte>(cube.buffers()[0]));
+    builder.attr_position(position);
+    builder.attr_normal(cube.attr_normal());
+
+    std::size_t joint_buffer = builder.add_buffer(
+        std::span<const std::array<std::uint8_t, 4>>(joints));
+    std::size_t weight_buffer
+        = builder.add_buffer(std::span<const vec4>(weights));
+
+    builder.attr_joints({ joint_buffer, 0, 4, Mesh::DataType::UNSIGNED_BYTE });
+    builder.attr_weights({ weight_buffer, 0, sizeof(vec4) });
+    return std::make_shared<Mesh>(builder.build());
+}
+
+TEST(Headless, ReadBack)
+{
+    FrameReadback frame;
+
+    ASSERT_NO_FATAL_FAILURE(render(frame, [](App& app) {
+        app.world().create_entity(Light::ambient(1.0f));
+        app.world().create_entity(
+            Transform {}, MeshRenderer { Mesh::make_cube(1.0f), orange() });
+    }));
+
+    if (IsSkipped()) {
+        return;
+    }
+
+    expect_color(frame, vec3(255.0f, 128.0f, 64.0f));
+}
+
+// a cube lit by a point light between it and the camera
+static void render_point_light(FrameReadback& frame, bool clustered)
+{
+    render(frame, [clustered](App& app) {
+        app.world().create_entity(
+            Transform::from_pos(vec3(0.0f, 0.0f, 1.5f)),
+            Light::point(1.0f, 4.0f));
+        app.world().create_entity(
+            Transform {}, MeshRenderer { Mesh::make_cube(1.0f), orange() });
+
+        app.render_world().insert(LightPassOptions {
+            .clustered = clustered,
+        });
+    });
+}
+
+TEST(Headless, PointLight)
+{
+    FrameReadback frame;
+
+    ASSERT_NO_FATAL_FAILURE(render_point_light(frame, false));
+
+    if (IsSkipped()) {
+        return;
+    }
+
+    expect_color(frame, vec3(239.0f, 120.0f, 60.0f));
+}
+
+TEST(Headless, ClusteredPointLight)
+{
+    FrameReadback frame;
+
+    ASSERT_NO_FATAL_FAILURE(render_point_light(frame, true));
+
+    if (IsSkipped()) {
+        return;
+    }
+
+    expect_color(frame, vec3(239.0f, 120.0f, 60.0f));
+}
+
+TEST(Headless, SkinnedMesh)
+{
+    FrameReadback frame;
+
+    // the joint moves the cube back from out of the frame to the origin
+    ASSERT_NO_FATAL_FAILURE(render(frame, [](App& app) {
+        auto skeleton = std::make_shared<Skeleton>();
+        skeleton->joints.push_back({ mat4(1.0f), std::nullopt });
+
+        SkeletonPose pose(skeleton);
+        pose.global_pose[0]
+            = glm::translate(mat4(1.0f), vec3(-10.0f, 0.0f, 0.0f));
+
+        auto skin = app.world().create_entity(std::move(pose));
+
+        app.world().create_entity(Light::ambient(1.0f));
+        app.world().create_entity(
+            Transform::from_pos(vec3(10.0f, 0.0f, 0.0f)),
+            MeshRenderer { skinned_cube(1.0f), orange(), skin });
+    }));
+
+    if (IsSkipped()) {
+        return;
+    }
+
+    expect_color(frame, vec3(255.0f, 128.0f, 64.0f));
+}
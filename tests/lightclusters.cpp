@@ -0,0 +1,133 @@
+#include "ige/core/Bounds.hpp"
+#include "ige/plugin/render/LightClusters.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <random>
+#include <vector>
+
+using glm::mat4;
+using glm::vec3;
+using glm::vec4;
+using ige::core::BoundingSphere;
+using ige::plugin::render::LightClusters;
+
+const float FOV = glm::radians(70.0f);
+const float ASPECT = 16.0f / 9.0f;
+const float Z_NEAR = 0.1f;
+const float Z_FAR = 100.0f;
+
+static bool has_light(
+    const LightClusters& clusters, std::size_t cluster, std::uint32_t light)
+{
+    auto [offset, count] = clusters.clusters()[cluster];
+    auto lights = clusters.indices().subspan(offset, count);
+
+    return std::find(lights.begin(), lights.end(), light) != lights.end();
+}
+
+// cluster containing a view-space point
+static std::size_t cluster_at(const LightClusters& clusters, vec3 point)
+{
+    mat4 projection = glm::perspective(FOV, ASPECT, Z_NEAR, Z_FAR);
+    vec4 clip = projection * vec4(point, 1.0f);
+    float x = (clip.x / clip.w * 0.5f + 0.5f) * LightClusters::TILES_X;
+    float y = (clip.y / clip.w * 0.5f + 0.5f) * LightClusters::TILES_Y;
+
+    return LightClusters::index(
+        std::size_t(x), std::size_t(y), clusters.slice(-point.z));
+}
+
+TEST(LightClusters, Slices)
+{
+    LightClusters clusters;
+    clusters.set_projection(FOV, ASPECT, Z_NEAR, Z_FAR);
+
+    EXPECT_EQ(clusters.slice(Z_NEAR), 0);
+    EXPECT_EQ(clusters.slice(Z_FAR * 0.999f), LightClusters::SLICES - 1);
+    EXPECT_EQ(clusters.slice(Z_FAR * 2.0f), LightClusters::SLICES - 1);
+    EXPECT_LT(clusters.slice(1.0f), clusters.slice(10.0f));
+}
+
+TEST(LightClusters, SmallLight)
+{
+    LightClusters clusters;
+    clusters.set_projection(FOV, ASPECT, Z_NEAR, Z_FAR);
+
+    BoundingSphere light { { 0.3f, -0.2f, -10.0f }, 0.01f };
+    clusters.assign({ &light, 1 });
+
+    EXPECT_TRUE(has_light(clusters, cluster_at(clusters, light.center), 0));
+    EXPECT_LE(clusters.indices().size(), 8);
+}
+
+TEST(LightClusters, OutOfView)
+{
+    LightClusters clusters;
+    clusters.set_projection(FOV, ASPECT, Z_NEAR, Z_FAR);
+
+    BoundingSphere lights[] = {
+        { { 0, 0, 10 }, 1.0f },    // behind the camera
+        { { 0, 0, -200 }, 1.0f },  // beyond the far plane
+        { { -50, 0, -10 }, 1.0f }, // on the left
+        { { 0, 40, -10 }, 1.0f },  // above
+    };
+
+    clusters.assign(lights);
+
+    EXPECT_TRUE(clusters.indices().empty());
+}
+
+TEST(LightClusters, Conservative)
+{
+    LightClusters clusters;
+    clusters.set_projection(FOV, ASPECT, Z_NEAR, Z_FAR);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> xy(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> depth(0.5f, 60.0f);
+    std::uniform_real_distribution<float> radius(0.1f, 5.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<BoundingSphere> lights(500);
+
+    for (auto& light : lights) {
+        light.center = { xy(rng), xy(rng), -depth(rng) };
+        light.radius = radius(rng);
+    }
+
+    clusters.assign(lights);
+
+    std::size_t total = 0;
+
+    for (const auto& cluster : clusters.clusters()) {
+        EXPECT_EQ(cluster.offset, total);
+        total += cluster.count;
+    }
+
+    EXPECT_EQ(total, clusters.indices().size());
+
+    mat4 projection = glm::perspective(FOV, ASPECT, Z_NEAR, Z_FAR);
+
+    // every visible point of a light's volume is in a cluster it belongs to
+    for (std::uint32_t i = 0; i < lights.size(); i++) {
+        for (int sample = 0; sample < 20; sample++) {
+            vec3 point = lights[i].center
+                + vec3(unit(rng), unit(rng), unit(rng)) * lights[i].radius
+                    * 0.57f;
+            vec4 clip = projection * vec4(point, 1.0f);
+
+            if (clip.w <= Z_NEAR || glm::abs(clip.x) >= clip.w
+                || glm::abs(clip.y) >= clip.w || -point.z >= Z_FAR) {
+                continue;
+            }
+
+            EXPECT_TRUE(has_light(clusters, cluster_at(clusters, point), i))
+                << "light " << i;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "ige/asset/Mesh.hpp"
+#include "ige/core/App.hpp"
+#include "ige/core/State.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using ige::asset::Mesh;
+using ige::core::App;
+using ige::core::State;
+using ige::ecs::EntityId;
+using ige::ecs::World;
+using ige::plugin::render::MeshRenderer;
+using ige::plugin::render::RenderPlugin;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::TransformPlugin;
+using ige::plugin::transform::WorldBounds;
+
+using Frame = std::function<void(World&)>;
+
+// runs one function per frame, before the update systems
+class Frames : public State {
+public:
+    Frames(std::vector<Frame> frames)
+        : m_frames(std::move(frames))
+    {
+    }
+
+    void on_update(App& app) override
+    {
+        m_frames[m_next++](app.world());
+
+        if (m_next == m_frames.size()) {
+            app.quit();
+        }
+    }
+
+private:
+    std::vector<Frame> m_frames;
+    std::size_t m_next = 0;
+};
+
+// without a window, nothing is drawn but bounds are still computed
+static void run_frames(std::vector<Frame> frames)
+{
+    App::Builder()
+        .add_plugin(TransformPlugin {})
+        .add_plugin(RenderPlugin {})
+        .run<Frames>(std::move(frames));
+}
+
+static void expect_bounds_of(World& world, EntityId entity, const Mesh& mesh)
+{
+    auto bounds = world.get_component<WorldBounds>(entity);
+
+    ASSERT_NE(bounds, nullptr);
+    EXPECT_EQ(bounds->mesh(), &mesh);
+    EXPECT_EQ(bounds->local_aabb(), mesh.bounds());
+    EXPECT_EQ(bounds->local_sphere(), mesh.bounding_sphere());
+}
+
+TEST(MeshBounds, AddedWithRenderer)
+{
+    auto mesh = Mesh::make_cube(1.0f);
+    std::optional<EntityId> entity;
+
+    run_frames({
+        [&](World& world) {
+            entity = world.create_entity(
+                Transform::from_pos({ 4, 0, 0 }), MeshRenderer { mesh });
+        },
+        [&](World& world) {
+            expect_bounds_of(world, *entity, *mesh);
+
+            auto bounds = world.get_component<WorldBounds>(*entity);
+            EXPECT_EQ(bounds->aabb().min.x, 3.5f);
+            EXPECT_EQ(bounds->aabb().max.x, 4.5f);
+        },
+    });
+}
+
+TEST(MeshBounds, TransformAddedLater)
+{
+    auto mesh = Mesh::make_cube(1.0f);
+    std::optional<EntityId> entity;
+
+    run_frames({
+        [&](World& world) {
+            entity = world.create_entity(MeshRenderer { mesh });
+        },
+        [&](World& world) {
+            EXPECT_EQ(world.get_component<WorldBounds>(*entity), nullptr);
+
+            world.emplace_component<Transform>(*entity);
+        },
+        [&](World& world) { expect_bounds_of(world, *entity, *mesh); },
+    });
+}
+
+TEST(MeshBounds, MeshSwappedInPlace)
+{
+    auto small = Mesh::make_cube(1.0f);
+    auto large = Mesh::make_cube(4.0f);
+    std::optional<EntityId> entity;
+
+    run_frames({
+        [&](World& world) {
+            entity = world.create_entity(Transform {}, MeshRenderer { small });
+        },
+        [&](World& world) {
+            expect_bounds_of(world, *entity, *small);
+
+            // the storage version doesn't change
+            world.get_component<MeshRenderer>(*entity)->mesh = large;
+        },
+        // noticed when extracting the frame, fixed by the next update
+        [&](World&) {},
+        [&](World& world) { expect_bounds_of(world, *entity, *large); },
+    });
+}
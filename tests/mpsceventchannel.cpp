@@ -0,0 +1,152 @@
+#include "ige/core/EventChannel.hpp"
+#include "ige/core/MpscEventChannel.hpp"
+#include "ige/ecs/World.hpp"
+#include "gtest/gtest.h"
+#include <functional>
+#include <thread>
+#include <vector>
+
+using ige::core::EventChannel;
+using ige::core::MpscEventChannel;
+using ige::ecs::World;
+
+struct Message {
+    int producer;
+    int index;
+};
+
+TEST(MpscEventChannel, Flush)
+{
+    MpscEventChannel<int> mpsc;
+    EventChannel<int> channel;
+    auto sub = channel.subscribe();
+
+    mpsc.push(1);
+    mpsc.emplace(2);
+    ASSERT_FALSE(sub.next_event() != nullptr);
+
+    ASSERT_EQ(mpsc.flush(channel), 2);
+    ASSERT_EQ(*sub.next_event(), 1);
+    ASSERT_EQ(*sub.next_event(), 2);
+    ASSERT_FALSE(sub.next_event() != nullptr);
+
+    ASSERT_EQ(mpsc.flush(channel), 0);
+}
+
+// calls `on_move` whenever it is moved
+struct Echo {
+    static inline std::function<void()> on_move;
+
+    Echo() = default;
+    Echo(const Echo&) = default;
+    Echo& operator=(const Echo&) = default;
+
+    Echo(Echo&&)
+    {
+        on_move();
+    }
+
+    Echo& operator=(Echo&&)
+    {
+        return *this;
+    }
+};
+
+TEST(MpscEventChannel, FlushIsBounded)
+{
+    MpscEventChannel<Echo> mpsc;
+    EventChannel<Echo> channel;
+    auto publisher = mpsc.publisher();
+
+    // a producer that never stops
+    Echo::on_move = [&] { publisher.emplace(); };
+
+    mpsc.emplace();
+
+    // each flush only moves the events queued before it started
+    ASSERT_EQ(mpsc.flush(channel), 1);
+    ASSERT_EQ(mpsc.flush(channel), 1);
+
+    Echo::on_move = [] {};
+}
+
+TEST(MpscEventChannel, RecycleNodes)
+{
+    MpscEventChannel<int> mpsc;
+    EventChannel<int> channel;
+    auto sub = channel.subscribe();
+    auto publisher = mpsc.publisher();
+
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 10; i++) {
+            publisher.push(i);
+            mpsc.push(-i);
+        }
+
+        ASSERT_EQ(mpsc.flush(channel), 20);
+
+        for (int i = 0; i < 10; i++) {
+            ASSERT_EQ(*sub.next_event(), i);
+            ASSERT_EQ(*sub.next_event(), -i);
+        }
+    }
+}
+
+TEST(MpscEventChannel, ManyProducers)
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int EVENTS = 10000;
+
+    MpscEventChannel<Message> mpsc;
+    EventChannel<Message> channel;
+    auto sub = channel.subscribe();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([p, publisher = mpsc.publisher()]() mutable {
+            for (int i = 0; i < EVENTS; i++) {
+                publisher.push({ p, i });
+            }
+        });
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+
+    auto consume = [&] {
+        mpsc.flush(channel);
+
+        while (auto msg = sub.next_event()) {
+            // events of a single producer arrive in order
+            ASSERT_EQ(msg->index, next[msg->producer]);
+            next[msg->producer]++;
+            received++;
+        }
+    };
+
+    while (received < PRODUCERS * EVENTS) {
+        consume();
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    consume();
+    ASSERT_EQ(received, PRODUCERS * EVENTS);
+}
+
+TEST(MpscEventChannel, FlushSystem)
+{
+    World world;
+    auto& channel = world.emplace<EventChannel<int>>();
+    auto sub = channel.subscribe();
+
+    ige::core::flush_event_channel<int>(world);
+
+    world.emplace<MpscEventChannel<int>>().push(3);
+    ige::core::flush_event_channel<int>(world);
+
+    ASSERT_EQ(*sub.next_event(), 3);
+    ASSERT_FALSE(sub.next_event() != nullptr);
+}
@@ -0,0 +1,110 @@
+#include "ige/core/RadixSort.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using ige::core::RadixSort;
+
+// sort with std::stable_sort and compare
+static void expect_sorted(
+    RadixSort& radix, std::vector<std::uint64_t> keys,
+    std::vector<std::uint32_t> values)
+{
+    std::vector<std::uint32_t> order(keys.size());
+
+    for (std::uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+        return keys[a] < keys[b];
+    });
+
+    std::vector<std::uint64_t> expected_keys;
+    std::vector<std::uint32_t> expected_values;
+
+    for (auto i : order) {
+        expected_keys.push_back(keys[i]);
+        expected_values.push_back(values[i]);
+    }
+
+    radix.sort(keys, values);
+
+    EXPECT_EQ(keys, expected_keys);
+    EXPECT_EQ(values, expected_values);
+}
+
+TEST(RadixSort, Empty)
+{
+    RadixSort radix;
+    std::vector<std::uint64_t> keys;
+    std::vector<std::uint32_t> values;
+
+    radix.sort(keys, values);
+
+    std::uint64_t key = 42;
+    std::uint32_t value = 7;
+
+    radix.sort({ &key, 1 }, { &value, 1 });
+
+    EXPECT_EQ(key, 42);
+    EXPECT_EQ(value, 7);
+}
+
+TEST(RadixSort, Random)
+{
+    RadixSort radix;
+    std::mt19937_64 rng(1);
+    std::vector<std::uint64_t> keys(5000);
+    std::vector<std::uint32_t> values(keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        keys[i] = rng();
+        values[i] = static_cast<std::uint32_t>(i);
+    }
+
+    expect_sorted(radix, keys, values);
+}
+
+TEST(RadixSort, Stable)
+{
+    RadixSort radix;
+    std::mt19937_64 rng(2);
+
+    // few distinct keys, differing in a single high byte
+    std::vector<std::uint64_t> keys(1000);
+    std::vector<std::uint32_t> values(keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        keys[i] = (rng() % 4) << 40;
+        values[i] = static_cast<std::uint32_t>(i);
+    }
+
+    expect_sorted(radix, keys, values);
+}
+
+TEST(RadixSort, OddNumberOfPasses)
+{
+    RadixSort radix;
+    std::mt19937_64 rng(3);
+
+    // only the 3 low bytes vary
+    std::vector<std::uint64_t> keys(777);
+    std::vector<std::uint32_t> values(keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        keys[i] = (rng() & 0xFFFFFF) | 0xAB00000000000000;
+        values[i] = static_cast<std::uint32_t>(i);
+    }
+
+    expect_sorted(radix, keys, values);
+
+    // reusing the same instance with fewer keys
+    keys.resize(10);
+    values.resize(10);
+    std::reverse(keys.begin(), keys.end());
+
+    expect_sorted(radix, keys, values);
+}
@@ -0,0 +1,112 @@
+#include "ige/core/SmallVector.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+using ige::core::SmallVector;
+
+TEST(SmallVector, Inline)
+{
+    SmallVector<int, 4> vec;
+
+    ASSERT_TRUE(vec.empty());
+
+    vec.push_back(1);
+    vec.push_back(2);
+    vec.push_back(3);
+
+    ASSERT_EQ(vec.size(), 3);
+    ASSERT_EQ(vec.capacity(), 4);
+    ASSERT_EQ(vec[0], 1);
+    ASSERT_EQ(vec[1], 2);
+    ASSERT_EQ(vec[2], 3);
+}
+
+TEST(SmallVector, Grow)
+{
+    SmallVector<int, 2> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(i);
+    }
+
+    ASSERT_EQ(vec.size(), 100);
+    ASSERT_GE(vec.capacity(), 100);
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(vec[i], i);
+    }
+}
+
+TEST(SmallVector, Stack)
+{
+    SmallVector<int, 2> vec;
+
+    vec.push_back(1);
+    vec.push_back(2);
+    vec.push_back(3);
+
+    ASSERT_EQ(vec.back(), 3);
+    vec.pop_back();
+    ASSERT_EQ(vec.back(), 2);
+    vec.pop_back();
+    ASSERT_EQ(vec.back(), 1);
+    vec.pop_back();
+    ASSERT_TRUE(vec.empty());
+}
+
+TEST(SmallVector, Erase)
+{
+    SmallVector<int, 4> vec;
+
+    for (int i = 0; i < 6; i++) {
+        vec.push_back(i);
+    }
+
+    auto it = vec.erase(std::find(vec.begin(), vec.end(), 2));
+
+    ASSERT_EQ(*it, 3);
+    ASSERT_EQ(
+        std::vector<int>(vec.begin(), vec.end()),
+        std::vector<int>({ 0, 1, 3, 4, 5 }));
+
+    vec.erase(vec.end() - 1);
+
+    ASSERT_EQ(
+        std::vector<int>(vec.begin(), vec.end()),
+        std::vector<int>({ 0, 1, 3, 4 }));
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+    SmallVector<int, 2> small;
+    SmallVector<int, 2> big;
+
+    small.push_back(1);
+
+    for (int i = 0; i < 10; i++) {
+        big.push_back(i);
+    }
+
+    SmallVector<int, 2> small_copy = small;
+    SmallVector<int, 2> big_copy = big;
+
+    ASSERT_EQ(small_copy.size(), 1);
+    ASSERT_EQ(small_copy[0], 1);
+    ASSERT_EQ(big_copy.size(), 10);
+    ASSERT_EQ(big_copy[9], 9);
+
+    SmallVector<int, 2> small_moved = std::move(small);
+    SmallVector<int, 2> big_moved = std::move(big);
+
+    ASSERT_TRUE(small.empty());
+    ASSERT_TRUE(big.empty());
+    ASSERT_EQ(small_moved[0], 1);
+    ASSERT_EQ(big_moved.size(), 10);
+    ASSERT_EQ(big_moved[9], 9);
+
+    big_moved = small_moved;
+
+    ASSERT_EQ(big_moved.size(), 1);
+    ASSERT_EQ(big_moved[0], 1);
+}
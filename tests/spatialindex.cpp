@@ -0,0 +1,274 @@
+#include "ige/core/App.hpp"
+#include "ige/core/Bounds.hpp"
+#include "ige/core/State.hpp"
+#include "ige/ecs/Entity.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/SpatialIndexPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/vec3.hpp>
+#include <random>
+#include <vector>
+
+using glm::vec3;
+using ige::core::Aabb;
+using ige::core::App;
+using ige::core::BoundingSphere;
+using ige::core::Frustum;
+using ige::core::Ray;
+using ige::core::State;
+using ige::ecs::EntityId;
+using ige::ecs::World;
+using ige::plugin::spatial::SpatialIndex;
+using ige::plugin::spatial::SpatialIndexPlugin;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::TransformPlugin;
+using ige::plugin::transform::WorldBounds;
+
+struct Scene {
+    std::mt19937 rng { 42 };
+    std::vector<EntityId> entities;
+    std::vector<Aabb> boxes;
+
+    Aabb random_box()
+    {
+        std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+        vec3 min { pos(rng), pos(rng), pos(rng) };
+        vec3 max = min + vec3 { size(rng), size(rng), size(rng) };
+
+        return { min, max };
+    }
+
+    Scene(SpatialIndex& index, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            entities.push_back(EntityId(i, 0));
+            boxes.push_back(random_box());
+            index.update(entities[i], boxes[i]);
+        }
+    }
+
+    // entities whose box passes the test, and that the index must return
+    template <typename F>
+    std::vector<EntityId> expected(F&& test) const
+    {
+        std::vector<EntityId> result;
+
+        for (std::size_t i = 0; i < entities.size(); i++) {
+            if (test(boxes[i])) {
+                result.push_back(entities[i]);
+            }
+        }
+
+        return result;
+    }
+};
+
+// the index may return more entities (their fat boxes match), but never less
+static void
+expect_superset(std::vector<EntityId> actual, std::vector<EntityId> expected)
+{
+    auto by_index = [](EntityId a, EntityId b) {
+        return a.index() < b.index();
+    };
+
+    std::sort(actual.begin(), actual.end(), by_index);
+    std::sort(expected.begin(), expected.end(), by_index);
+
+    EXPECT_TRUE(std::includes(
+        actual.begin(), actual.end(), expected.begin(), expected.end(),
+        by_index));
+    EXPECT_EQ(
+        std::adjacent_find(actual.begin(), actual.end()), actual.end());
+}
+
+TEST(SpatialIndex, Empty)
+{
+    SpatialIndex index;
+    std::vector<EntityId> out { EntityId(0, 0) };
+
+    index.query(Aabb { vec3(-1.0f), vec3(1.0f) }, out);
+
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(index.size(), 0);
+}
+
+TEST(SpatialIndex, Queries)
+{
+    SpatialIndex index;
+    Scene scene(index, 1000);
+    std::vector<EntityId> out;
+
+    ASSERT_EQ(index.size(), 1000);
+
+    Aabb box { vec3(-20.0f), vec3(30.0f) };
+    index.query(box, out);
+    expect_superset(out, scene.expected([&](auto b) {
+        return b.intersects(box);
+    }));
+
+    BoundingSphere sphere { vec3(10.0f, -5.0f, 0.0f), 25.0f };
+    index.query(sphere, out);
+    expect_superset(out, scene.expected([&](auto b) {
+        return b.intersects(sphere);
+    }));
+
+    Ray ray { vec3(-150.0f, 0.0f, 0.0f), glm::normalize(vec3(1, 0.1f, 0)) };
+    index.query(ray, 300.0f, out);
+    expect_superset(out, scene.expected([&](auto b) {
+        return b.intersects(ray, 300.0f);
+    }));
+
+    Frustum frustum = Frustum::from_matrix(
+        glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 80.0f));
+    index.query(frustum, out);
+    expect_superset(out, scene.expected([&](auto b) {
+        return frustum.intersects(b);
+    }));
+
+    // nothing far away
+    for (auto entity : out) {
+        Aabb fat = scene.boxes[entity.index()].inflated(vec3(1.0f));
+
+        EXPECT_TRUE(frustum.intersects(fat));
+    }
+}
+
+TEST(SpatialIndex, UpdateAndRemove)
+{
+    SpatialIndex index;
+    Scene scene(index, 500);
+    std::vector<EntityId> out;
+
+    for (std::size_t i = 0; i < scene.entities.size(); i += 2) {
+        scene.boxes[i] = scene.random_box();
+        index.update(scene.entities[i], scene.boxes[i]);
+    }
+
+    for (std::size_t i = 1; i < scene.entities.size(); i += 4) {
+        index.remove(scene.entities[i]);
+        EXPECT_FALSE(index.contains(scene.entities[i]));
+        scene.boxes[i] = Aabb { vec3(1000.0f), vec3(1001.0f) };
+    }
+
+    EXPECT_EQ(index.size(), 375);
+
+    Aabb box { vec3(-50.0f), vec3(50.0f) };
+    index.query(box, out);
+    expect_superset(out, scene.expected([&](auto b) {
+        return b.intersects(box);
+    }));
+
+    for (auto entity : out) {
+        EXPECT_TRUE(index.contains(entity));
+    }
+
+    index.rebalance();
+    EXPECT_TRUE(index.balanced());
+    EXPECT_EQ(index.size(), 375);
+
+    std::vector<EntityId> rebalanced;
+    index.query(box, rebalanced);
+    EXPECT_EQ(rebalanced.size(), out.size());
+}
+
+TEST(SpatialIndex, SortedInsertions)
+{
+    SpatialIndex index;
+
+    // worst case for a tree without rotations
+    for (std::size_t i = 0; i < 4096; i++) {
+        float x = static_cast<float>(i);
+
+        index.update(EntityId(i, 0), Aabb { vec3(x), vec3(x + 0.5f) });
+    }
+
+    if (!index.balanced()) {
+        index.rebalance();
+    }
+
+    EXPECT_TRUE(index.balanced());
+    EXPECT_LE(index.height(), 2 * 13 + 4);
+}
+
+TEST(SpatialIndex, ReusedEntityIndex)
+{
+    SpatialIndex index;
+    Aabb box { vec3(0.0f), vec3(1.0f) };
+
+    index.update(EntityId(3, 0), box);
+    index.update(EntityId(3, 1), box);
+
+    EXPECT_FALSE(index.contains(EntityId(3, 0)));
+    EXPECT_TRUE(index.contains(EntityId(3, 1)));
+    EXPECT_EQ(index.size(), 1);
+
+    index.remove(EntityId(3, 0));
+    EXPECT_EQ(index.size(), 1);
+}
+
+class Frames : public State {
+public:
+    Frames(std::vector<std::function<void(World&)>> frames)
+        : m_frames(std::move(frames))
+    {
+    }
+
+    void on_update(App& app) override
+    {
+        m_frames[m_next++](app.world());
+
+        if (m_next == m_frames.size()) {
+            app.quit();
+        }
+    }
+
+private:
+    std::vector<std::function<void(World&)>> m_frames;
+    std::size_t m_next = 0;
+};
+
+TEST(SpatialIndexPlugin, FollowsTransforms)
+{
+    std::optional<EntityId> entity;
+    std::vector<EntityId> out;
+    Aabb origin { vec3(-1.0f), vec3(1.0f) };
+    Aabb far { vec3(49.0f), vec3(51.0f) };
+
+    std::vector<std::function<void(World&)>> frames {
+        [&](World& world) {
+            entity = world.create_entity(
+                Transform {},
+                WorldBounds { origin, BoundingSphere { vec3(0.0f), 1.0f } });
+        },
+        [&](World& world) {
+            world.get<SpatialIndex>()->query(origin, out);
+            EXPECT_EQ(out, std::vector { *entity });
+
+            world.get_component<Transform>(*entity)->set_translation(
+                vec3(50.0f));
+        },
+        [&](World& world) {
+            auto index = world.get<SpatialIndex>();
+
+            index->query(origin, out);
+            EXPECT_TRUE(out.empty());
+            index->query(far, out);
+            EXPECT_EQ(out, std::vector { *entity });
+
+            world.remove_entity(*entity);
+        },
+        [&](World& world) {
+            EXPECT_EQ(world.get<SpatialIndex>()->size(), 0);
+        },
+    };
+
+    App::Builder()
+        .add_plugin(TransformPlugin {})
+        .add_plugin(SpatialIndexPlugin {})
+        .run<Frames>(std::move(frames));
+}
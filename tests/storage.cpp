@@ -68,3 +68,22 @@ TYPED_TEST(StorageTest, StorageGetConst)
     ASSERT_EQ(*ref.get(0), 39);
     ASSERT_EQ(*ref.get(3), 49);
 }
+
+TYPED_TEST(StorageTest, StorageVersion)
+{
+    using Storage = typename TestFixture::Storage;
+
+    Storage storage;
+    auto version = storage.version();
+
+    storage.set(0, 39);
+    ASSERT_NE(storage.version(), version);
+
+    version = storage.version();
+    *storage.get(0) = 40;
+    storage.remove(3);
+    ASSERT_EQ(storage.version(), version);
+
+    storage.remove(0);
+    ASSERT_NE(storage.version(), version);
+}
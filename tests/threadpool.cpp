@@ -0,0 +1,72 @@
+#include "ige/core/ThreadPool.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using ige::core::ThreadPool;
+
+TEST(ThreadPool, ForEach)
+{
+    ThreadPool pool(4);
+    std::vector<int> values(1000, 0);
+
+    ASSERT_EQ(pool.size(), 4);
+
+    for (int round = 1; round <= 10; round++) {
+        pool.for_each(values.size(), [&](std::size_t i) { values[i]++; });
+
+        for (int value : values) {
+            ASSERT_EQ(value, round);
+        }
+    }
+}
+
+TEST(ThreadPool, SingleThread)
+{
+    ThreadPool pool(1);
+    std::atomic<int> sum = 0;
+
+    ASSERT_EQ(pool.size(), 1);
+
+    pool.for_each(10, [&](std::size_t i) { sum += static_cast<int>(i); });
+
+    ASSERT_EQ(sum, 45);
+}
+
+TEST(ThreadPool, Exception)
+{
+    ThreadPool pool(4);
+    std::atomic<int> done = 0;
+
+    ASSERT_THROW(
+        pool.for_each(
+            100,
+            [&](std::size_t i) {
+                if (i == 42) {
+                    throw std::runtime_error("42");
+                }
+
+                done++;
+            }),
+        std::runtime_error);
+
+    // other jobs still ran
+    ASSERT_EQ(done, 99);
+
+    // the pool is still usable
+    pool.for_each(10, [&](std::size_t) { done++; });
+    ASSERT_EQ(done, 109);
+}
+
+TEST(ThreadPool, Move)
+{
+    ThreadPool pool(3);
+    ThreadPool moved = std::move(pool);
+    std::atomic<int> count = 0;
+
+    moved.for_each(50, [&](std::size_t) { count++; });
+
+    ASSERT_EQ(count, 50);
+}
@@ -0,0 +1,508 @@
+#include "ige/core/App.hpp"
+#include "ige/core/Bounds.hpp"
+#include "ige/core/State.hpp"
+#include "ige/core/ThreadPool.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "ige/plugin/WindowPlugin.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <functional>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using glm::vec2;
+using glm::vec3;
+using ige::core::Aabb;
+using ige::core::App;
+using ige::core::BoundingSphere;
+using ige::core::State;
+using ige::core::ThreadPool;
+using ige::ecs::EntityId;
+using ige::ecs::World;
+using ige::plugin::transform::Children;
+using ige::plugin::transform::Parent;
+using ige::plugin::transform::RectTransform;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::TransformPlugin;
+using ige::plugin::transform::WorldBounds;
+using ige::plugin::window::WindowInfo;
+
+using Frame = std::function<void(World&)>;
+
+// runs one function per frame, before the update systems
+class Frames : public State {
+public:
+    Frames(std::vector<Frame> frames)
+        : m_frames(std::move(frames))
+    {
+    }
+
+    void on_update(App& app) override
+    {
+        m_frames[m_next++](app.world());
+
+        if (m_next == m_frames.size()) {
+            app.quit();
+        }
+    }
+
+private:
+    std::vector<Frame> m_frames;
+    std::size_t m_next = 0;
+};
+
+static void run_frames(std::vector<Frame> frames)
+{
+    App::Builder().add_plugin(TransformPlugin {}).run<Frames>(
+        std::move(frames));
+}
+
+static std::vector<EntityId> children_of(World& world, EntityId entity)
+{
+    auto children = world.get_component<Children>(entity);
+
+    if (!children) {
+        return {};
+    }
+
+    std::vector<EntityId> entities(
+        children->entities.begin(), children->entities.end());
+
+    // the order of children isn't specified
+    std::sort(entities.begin(), entities.end(), [](auto a, auto b) {
+        return a.index() < b.index();
+    });
+
+    return entities;
+}
+
+static void expect_world_translation(World& world, EntityId entity, vec3 pos)
+{
+    auto xform = world.get_component<Transform>(entity);
+
+    ASSERT_NE(xform, nullptr);
+
+    vec3 actual = xform->world_translation();
+    EXPECT_NEAR(actual.x, pos.x, 1e-5f);
+    EXPECT_NEAR(actual.y, pos.y, 1e-5f);
+    EXPECT_NEAR(actual.z, pos.z, 1e-5f);
+}
+
+static void
+expect_abs_bounds(World& world, EntityId entity, vec2 min, vec2 max)
+{
+    auto rect = world.get_component<RectTransform>(entity);
+
+    ASSERT_NE(rect, nullptr);
+    EXPECT_EQ(rect->abs_bounds_min(), min);
+    EXPECT_EQ(rect->abs_bounds_max(), max);
+}
+
+TEST(Transform, ChildFollowsParent)
+{
+    std::optional<EntityId> root, child, grandchild;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform::from_pos({ 1, 0, 0 }));
+            child = world.create_entity(
+                Transform::from_pos({ 0, 2, 0 }), Parent { *root });
+            grandchild = world.create_entity(
+                Transform::from_pos({ 0, 0, 3 }), Parent { *child });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *grandchild, { 1, 2, 3 });
+
+            world.get_component<Transform>(*root)->set_translation(
+                { 5, 0, 0 });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *root, { 5, 0, 0 });
+            expect_world_translation(world, *child, { 5, 2, 0 });
+            expect_world_translation(world, *grandchild, { 5, 2, 3 });
+
+            world.get_component<Transform>(*child)->translate({ 0, 1, 0 });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *root, { 5, 0, 0 });
+            expect_world_translation(world, *child, { 5, 3, 0 });
+            expect_world_translation(world, *grandchild, { 5, 3, 3 });
+        },
+    });
+}
+
+TEST(Transform, Reparent)
+{
+    std::optional<EntityId> a, b, child;
+
+    run_frames({
+        [&](World& world) {
+            a = world.create_entity(Transform::from_pos({ 1, 0, 0 }));
+            b = world.create_entity(Transform::from_pos({ 0, 1, 0 }));
+            child = world.create_entity(
+                Transform::from_pos({ 0, 0, 1 }), Parent { *a });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *child, { 1, 0, 1 });
+
+            world.emplace_component<Parent>(*child, *b);
+            world.get_component<Transform>(*child)->set_translation(
+                { 0, 0, 2 });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *child, { 0, 1, 2 });
+        },
+    });
+}
+
+TEST(Transform, ReparentClean)
+{
+    std::optional<EntityId> a, b, child;
+
+    run_frames({
+        [&](World& world) {
+            a = world.create_entity(Transform::from_pos({ 1, 0, 0 }));
+            b = world.create_entity(Transform::from_pos({ 0, 1, 0 }));
+            child = world.create_entity(
+                Transform::from_pos({ 0, 0, 1 }), Parent { *a });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *child, { 1, 0, 1 });
+
+            // the transform of the child itself doesn't change
+            world.emplace_component<Parent>(*child, *b);
+        },
+        [&](World& world) {
+            expect_world_translation(world, *child, { 0, 1, 1 });
+
+            ASSERT_EQ(children_of(world, *a), std::vector<EntityId>());
+            ASSERT_EQ(
+                children_of(world, *b), std::vector<EntityId>({ *child }));
+        },
+    });
+}
+
+TEST(Transform, NewChildOfStaticParent)
+{
+    std::optional<EntityId> root, child;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform::from_pos({ 1, 2, 3 }));
+        },
+        [&](World& world) {
+            child = world.create_entity(Transform {}, Parent { *root });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *child, { 1, 2, 3 });
+        },
+    });
+}
+
+TEST(Transform, ChildOfEntityWithoutTransform)
+{
+    std::optional<EntityId> root, child, grandchild;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity();
+            child = world.create_entity(
+                Transform::from_pos({ 1, 2, 3 }), Parent { *root });
+            grandchild = world.create_entity(
+                Transform::from_pos({ 0, 1, 0 }), Parent { *child });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *child, { 1, 2, 3 });
+            expect_world_translation(world, *grandchild, { 1, 3, 3 });
+
+            world.get_component<Transform>(*child)->set_translation(
+                { 0, 0, 0 });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *grandchild, { 0, 1, 0 });
+        },
+    });
+}
+
+TEST(Transform, RemoveChild)
+{
+    std::optional<EntityId> root, a, b, c;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {});
+            a = world.create_entity(Transform {}, Parent { *root });
+            b = world.create_entity(Transform {}, Parent { *root });
+            c = world.create_entity(Transform {}, Parent { *root });
+        },
+        [&](World& world) {
+            ASSERT_EQ(
+                children_of(world, *root),
+                std::vector<EntityId>({ *a, *b, *c }));
+
+            world.remove_entity(*b);
+            world.remove_component<Parent>(*c);
+        },
+        [&](World& world) {
+            ASSERT_EQ(children_of(world, *root), std::vector<EntityId>({ *a }));
+        },
+    });
+}
+
+TEST(Transform, RemoveParent)
+{
+    std::optional<EntityId> root, child, grandchild, other;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {});
+            child = world.create_entity(Transform {}, Parent { *root });
+            grandchild = world.create_entity(Transform {}, Parent { *child });
+            other = world.create_entity(Transform {});
+        },
+        [&](World& world) { world.remove_entity(*root); },
+        [&](World& world) {
+            // orphans are removed, and their own children the frame after
+            ASSERT_FALSE(world.exists(*child));
+            ASSERT_TRUE(world.exists(*other));
+        },
+        [&](World& world) {
+            ASSERT_FALSE(world.exists(*grandchild));
+            ASSERT_TRUE(world.exists(*other));
+        },
+    });
+}
+
+TEST(Transform, NestedChanges)
+{
+    std::optional<EntityId> a, a_child, b, b_child;
+
+    run_frames({
+        [&](World& world) {
+            a = world.create_entity(Transform::from_pos({ 1, 0, 0 }));
+            a_child = world.create_entity(
+                Transform::from_pos({ 0, 1, 0 }), Parent { *a });
+            b = world.create_entity(Transform::from_pos({ 2, 0, 0 }));
+            b_child = world.create_entity(
+                Transform::from_pos({ 0, 2, 0 }), Parent { *b });
+        },
+        [&](World& world) {
+            // both a node and its descendant changed
+            world.get_component<Transform>(*a_child)->translate({ 0, 0, 1 });
+            world.get_component<Transform>(*a)->translate({ 0, 0, 1 });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *a, { 1, 0, 1 });
+            expect_world_translation(world, *a_child, { 1, 1, 2 });
+            expect_world_translation(world, *b, { 2, 0, 0 });
+            expect_world_translation(world, *b_child, { 2, 2, 0 });
+
+            *world.get_component<Transform>(*b)
+                = Transform::from_pos({ 3, 0, 0 });
+        },
+        [&](World& world) {
+            expect_world_translation(world, *a_child, { 1, 1, 2 });
+            expect_world_translation(world, *b_child, { 3, 2, 0 });
+        },
+    });
+}
+
+TEST(Transform, ManyHierarchies)
+{
+    // enough nodes for the update to be spread across threads
+    const int roots = 64;
+    const int depth = 20;
+
+    std::vector<EntityId> root_entities;
+    std::vector<EntityId> leaves;
+
+    auto check_leaves = [&](World& world, float offset) {
+        for (int i = 0; i < roots; i++) {
+            expect_world_translation(
+                world, leaves[i],
+                { static_cast<float>(i) + offset, depth - 1.0f, 0 });
+        }
+    };
+
+    run_frames({
+        [&](World& world) {
+            world.emplace<ThreadPool>(4);
+
+            for (int i = 0; i < roots; i++) {
+                EntityId entity = world.create_entity(
+                    Transform::from_pos({ static_cast<float>(i), 0, 0 }));
+
+                root_entities.push_back(entity);
+
+                for (int j = 1; j < depth; j++) {
+                    entity = world.create_entity(
+                        Transform::from_pos({ 0, 1, 0 }), Parent { entity });
+                }
+
+                leaves.push_back(entity);
+            }
+        },
+        [&](World& world) {
+            check_leaves(world, 0.0f);
+
+            for (auto root : root_entities) {
+                world.get_component<Transform>(root)->translate({ 10, 0, 0 });
+            }
+        },
+        [&](World& world) { check_leaves(world, 10.0f); },
+    });
+}
+
+TEST(Transform, NoThreadPoolForSmallScenes)
+{
+    run_frames({
+        [](World& world) {
+            EntityId root = world.create_entity(Transform {});
+            world.create_entity(Transform {}, Parent { root });
+        },
+        [](World& world) { EXPECT_EQ(world.get<ThreadPool>(), nullptr); },
+    });
+}
+
+TEST(Transform, WorldToLocal)
+{
+    Transform xform = Transform::from_pos({ 1, 2, 3 }).set_scale(2.0f);
+
+    xform.force_update(glm::mat4(1.0f));
+
+    vec3 local = xform.world_to_local() * glm::vec4(3, 4, 5, 1);
+    EXPECT_NEAR(local.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(local.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(local.z, 1.0f, 1e-5f);
+
+    // the cached inverse must follow updates
+    xform.set_translation({ 0, 0, 0 });
+    xform.force_update(glm::mat4(1.0f));
+
+    local = xform.world_to_local() * glm::vec4(2, 2, 2, 1);
+    EXPECT_NEAR(local.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(local.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(local.z, 1.0f, 1e-5f);
+}
+
+TEST(Transform, ManySiblings)
+{
+    std::optional<EntityId> root;
+    std::vector<EntityId> children;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform::from_pos({ 0, 0, 1 }));
+
+            for (int i = 0; i < 100; i++) {
+                children.push_back(world.create_entity(
+                    Transform::from_pos({ static_cast<float>(i), 0, 0 }),
+                    Parent { *root }));
+            }
+        },
+        [&](World& world) {
+            for (int i = 0; i < 100; i++) {
+                expect_world_translation(
+                    world, children[i], { static_cast<float>(i), 0, 1 });
+            }
+        },
+    });
+}
+
+TEST(Transform, WorldBoundsFollowParent)
+{
+    std::optional<EntityId> root, child;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform::from_pos({ 1, 0, 0 }));
+            child = world.create_entity(
+                Transform::from_pos({ 0, 2, 0 }), Parent { *root },
+                WorldBounds {
+                    Aabb { vec3(-1.0f), vec3(1.0f) },
+                    BoundingSphere { vec3(0.0f), 1.0f },
+                });
+        },
+        [&](World& world) {
+            auto bounds = world.get_component<WorldBounds>(*child);
+
+            EXPECT_EQ(bounds->aabb().min, vec3(0, 1, -1));
+            EXPECT_EQ(bounds->aabb().max, vec3(2, 3, 1));
+            EXPECT_EQ(bounds->sphere().center, vec3(1, 2, 0));
+
+            world.get_component<Transform>(*root)->set_scale(2.0f);
+        },
+        [&](World& world) {
+            auto bounds = world.get_component<WorldBounds>(*child);
+
+            EXPECT_EQ(bounds->aabb().min, vec3(-1, 2, -2));
+            EXPECT_EQ(bounds->aabb().max, vec3(3, 6, 2));
+            EXPECT_EQ(bounds->sphere().radius, 2.0f);
+        },
+    });
+}
+
+TEST(RectTransform, FollowsParent)
+{
+    std::optional<EntityId> pane, button;
+
+    run_frames({
+        [&](World& world) {
+            world.insert(WindowInfo { 800, 600 });
+
+            pane = world.create_entity(
+                RectTransform {}.set_anchors({ 0.5f, 0.5f }).set_bounds(
+                    { -100, -50 }, { 100, 50 }));
+            button = world.create_entity(
+                RectTransform {}.set_bounds({ 10, 10 }, { -10, -10 }),
+                Parent { *pane });
+        },
+        [&](World& world) {
+            expect_abs_bounds(world, *pane, { 300, 250 }, { 500, 350 });
+            expect_abs_bounds(world, *button, { 310, 260 }, { 490, 340 });
+
+            world.get_component<RectTransform>(*pane)->set_bounds(
+                { -200, -50 }, { 200, 50 });
+        },
+        [&](World& world) {
+            expect_abs_bounds(world, *pane, { 200, 250 }, { 600, 350 });
+            expect_abs_bounds(world, *button, { 210, 260 }, { 590, 340 });
+            EXPECT_LT(
+                world.get_component<RectTransform>(*button)->abs_depth(),
+                world.get_component<RectTransform>(*pane)->abs_depth());
+        },
+    });
+}
+
+TEST(RectTransform, WindowResize)
+{
+    std::optional<EntityId> pane, button;
+
+    run_frames({
+        [&](World& world) {
+            world.insert(WindowInfo { 800, 600 });
+
+            pane = world.create_entity(RectTransform {});
+            button = world.create_entity(
+                RectTransform {}.set_anchors({ 1, 1 }).set_bounds(
+                    { -20, -20 }, { 0, 0 }),
+                Parent { *pane });
+        },
+        [&](World& world) {
+            expect_abs_bounds(world, *pane, { 0, 0 }, { 800, 600 });
+            expect_abs_bounds(world, *button, { 780, 580 }, { 800, 600 });
+
+            world.get<WindowInfo>()->width = 1024;
+        },
+        [&](World& world) {
+            expect_abs_bounds(world, *pane, { 0, 0 }, { 1024, 600 });
+            expect_abs_bounds(world, *button, { 1004, 580 }, { 1024, 600 });
+        },
+    });
+}
@@ -0,0 +1,195 @@
+#include "ige/core/App.hpp"
+#include "ige/core/State.hpp"
+#include "ige/ecs/World.hpp"
+#include "ige/plugin/RenderPlugin.hpp"
+#include "ige/plugin/TransformPlugin.hpp"
+#include "ige/plugin/render/InheritedVisibility.hpp"
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using ige::core::App;
+using ige::core::State;
+using ige::ecs::EntityId;
+using ige::ecs::World;
+using ige::plugin::render::InheritedVisibility;
+using ige::plugin::render::Visibility;
+using ige::plugin::transform::Parent;
+using ige::plugin::transform::Transform;
+using ige::plugin::transform::TransformPlugin;
+
+using Frame = std::function<void(World&)>;
+
+// runs one function per frame, before the update systems
+class Frames : public State {
+public:
+    Frames(std::vector<Frame> frames)
+        : m_frames(std::move(frames))
+    {
+    }
+
+    void on_update(App& app) override
+    {
+        m_frames[m_next++](app.world());
+
+        if (m_next == m_frames.size()) {
+            app.quit();
+        }
+    }
+
+private:
+    std::vector<Frame> m_frames;
+    std::size_t m_next = 0;
+};
+
+static void run_frames(std::vector<Frame> frames)
+{
+    App::Builder().add_plugin(TransformPlugin {}).run<Frames>(
+        std::move(frames));
+}
+
+// the hierarchy was rebuilt by the update systems of the previous frame
+static InheritedVisibility& propagate(World& world)
+{
+    auto& inherited = world.get_or_emplace<InheritedVisibility>();
+
+    inherited.update(world);
+    return inherited;
+}
+
+TEST(Visibility, HiddenParentHidesDescendants)
+{
+    std::optional<EntityId> root, child, grandchild;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {}, Visibility(false, 1.0f));
+            child = world.create_entity(Transform {}, Parent { *root });
+            grandchild = world.create_entity(Transform {}, Parent { *child });
+        },
+        [&](World& world) {
+            auto& inherited = propagate(world);
+
+            EXPECT_FALSE(world.get_component<Visibility>(*root)
+                             ->global_visible());
+            EXPECT_FALSE(inherited.visible(*child));
+            EXPECT_FALSE(inherited.visible(*grandchild));
+            EXPECT_TRUE(inherited.visible(*root));
+        },
+    });
+}
+
+TEST(Visibility, ChildrenDontGetVisibility)
+{
+    std::optional<EntityId> root, child;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {}, Visibility(0.5f));
+            child = world.create_entity(Transform {}, Parent { *root });
+        },
+        [&](World& world) {
+            auto& inherited = propagate(world);
+
+            EXPECT_EQ(world.get_component<Visibility>(*child), nullptr);
+            EXPECT_FLOAT_EQ(inherited.opacity(*child), 0.5f);
+        },
+    });
+}
+
+TEST(Visibility, OpacityMultiplies)
+{
+    std::optional<EntityId> root, child, grandchild;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {}, Visibility(0.5f));
+            child = world.create_entity(
+                Transform {}, Parent { *root }, Visibility(0.5f));
+            grandchild = world.create_entity(Transform {}, Parent { *child });
+        },
+        [&](World& world) {
+            auto& inherited = propagate(world);
+
+            EXPECT_FLOAT_EQ(
+                world.get_component<Visibility>(*child)->global_opacity(),
+                0.25f);
+            EXPECT_FLOAT_EQ(inherited.opacity(*grandchild), 0.25f);
+            EXPECT_TRUE(inherited.visible(*grandchild));
+        },
+    });
+}
+
+TEST(Visibility, NestedVisibilityOverridesParent)
+{
+    std::optional<EntityId> root, hidden, hidden_child, sibling;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {}, Visibility(0.5f));
+            hidden = world.create_entity(
+                Transform {}, Parent { *root }, Visibility(false, 1.0f));
+            hidden_child
+                = world.create_entity(Transform {}, Parent { *hidden });
+            sibling = world.create_entity(Transform {}, Parent { *root });
+        },
+        [&](World& world) {
+            auto& inherited = propagate(world);
+
+            // the closest `Visibility` is the one inherited
+            EXPECT_FALSE(inherited.visible(*hidden_child));
+            EXPECT_TRUE(inherited.visible(*sibling));
+            EXPECT_FLOAT_EQ(inherited.opacity(*sibling), 0.5f);
+        },
+    });
+}
+
+TEST(Visibility, InPlaceChange)
+{
+    std::optional<EntityId> root, child;
+
+    run_frames({
+        [&](World& world) {
+            root = world.create_entity(Transform {}, Visibility(true, 1.0f));
+            child = world.create_entity(Transform {}, Parent { *root });
+        },
+        [&](World& world) {
+            EXPECT_TRUE(propagate(world).visible(*child));
+
+            world.get_component<Visibility>(*root)->visible = false;
+
+            EXPECT_FALSE(propagate(world).visible(*child));
+        },
+        [&](World& world) {
+            EXPECT_FALSE(propagate(world).visible(*child));
+
+            world.get_component<Visibility>(*root)->visible = true;
+
+            EXPECT_TRUE(propagate(world).visible(*child));
+        },
+    });
+}
+
+TEST(Visibility, Reparent)
+{
+    std::optional<EntityId> hidden, shown, child;
+
+    run_frames({
+        [&](World& world) {
+            hidden = world.create_entity(Transform {}, Visibility(false, 1.0f));
+            shown = world.create_entity(Transform {});
+            child = world.create_entity(Transform {}, Parent { *hidden });
+        },
+        [&](World& world) {
+            EXPECT_FALSE(propagate(world).visible(*child));
+
+            world.emplace_component<Parent>(*child, *shown);
+        },
+        [&](World& world) {
+            EXPECT_TRUE(propagate(world).visible(*child));
+        },
+    });
+}
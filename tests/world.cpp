@@ -361,3 +361,19 @@ TEST(World, EntityQueryMixedStorage)
         }
     }
 }
+
+TEST(World, EntityAt)
+{
+    World world;
+
+    EntityId a = world.create_entity();
+    EntityId b = world.create_entity();
+
+    ASSERT_EQ(world.entity_at(a.index()), a);
+    ASSERT_EQ(world.entity_at(b.index()), b);
+
+    world.remove_entity(a);
+
+    ASSERT_EQ(world.entity_at(a.index()), std::nullopt);
+    ASSERT_EQ(world.entity_at(b.index()), b);
+}
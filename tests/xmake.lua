@@ -1,11 +1,24 @@
 add_requires("gtest ^1.11.0", {configs={main=true, gmock=true}})
 
 local tests = {
+    ["affine"] = { files = {"affine.cpp"} },
     ["any"] = { files = {"any.cpp"} },
+    ["app"] = { files = {"app.cpp"} },
+    ["bounds"] = { files = {"bounds.cpp"} },
     ["entity"] = { files = {"entity.cpp"} },
     ["eventchannel"] = { files = {"eventchannel.cpp"} },
+    ["headless"] = { files = {"headless.cpp"} },
+    ["lightclusters"] = { files = {"lightclusters.cpp"} },
+    ["meshbounds"] = { files = {"meshbounds.cpp"} },
+    ["mpsceventchannel"] = { files = {"mpsceventchannel.cpp"} },
+    ["radixsort"] = { files = {"radixsort.cpp"} },
+    ["smallvector"] = { files = {"smallvector.cpp"} },
+    ["spatialindex"] = { files = {"spatialindex.cpp"} },
     ["statemachine"] = { files = {"statemachine.cpp"} },
     ["storage"] = { files = {"storage.cpp"} },
+    ["threadpool"] = { files = {"threadpool.cpp"} },
+    ["transform"] = { files = {"transform.cpp"} },
+    ["visibility"] = { files = {"visibility.cpp"} },
     ["world"] = { files = {"world.cpp"} },
 }
 
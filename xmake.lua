@@ -6,4 +6,5 @@ add_plugindirs("xmake-plugin")
 
 includes("ige")
 includes("tests")
+includes("bench")
 includes("examples")